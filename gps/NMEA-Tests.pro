@@ -1,22 +1,69 @@
 TEMPLATE = app
-CONFIG += console c++11
+CONFIG += console c++11 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
+# For sanitizer builds, run "qmake CONFIG+=asan" (AddressSanitizer and UndefinedBehaviorSanitizer)
+# or "qmake CONFIG+=tsan" (ThreadSanitizer).
+asan {
+    CONFIG += sanitizer sanitize_address sanitize_undefined
+}
+tsan {
+    CONFIG += sanitizer sanitize_thread
+}
+
 HEADERS += \
+    headers/distance.h \
     headers/earth.h \
+    headers/elevationProfile.h \
+    headers/geofence.h \
     headers/geometry.h \
     headers/logs.h \
+    headers/nmeaPipeline.h \
+    headers/nmeaStream.h \
     headers/parseNMEA.h \
     headers/position.h \
+    headers/positionFilter.h \
+    headers/projection.h \
+    headers/ringBuffer.h \
+    headers/routeCache.h \
+    headers/routeLibrary.h \
+    headers/routeMatcher.h \
+    headers/routeSnapshot.h \
+    headers/routeSums.h \
+    headers/simplify.h \
     headers/types.h
 
 SOURCES += \
+    src/distance.cpp \
     src/earth.cpp \
-    src/geometry.cpp \
+    src/elevationProfile.cpp \
+    src/geofence.cpp \
     src/logs.cpp \
+    src/nmeaPipeline.cpp \
+    src/nmeaStream.cpp \
+    src/parseNMEA.cpp \
     src/position.cpp \
-    src/nmea-tests.cpp
+    src/positionFilter.cpp \
+    src/routeCache.cpp \
+    src/routeLibrary.cpp \
+    src/routeMatcher.cpp \
+    src/routeSnapshot.cpp \
+    src/routeSums.cpp \
+    src/simplify.cpp \
+    src/nmea-tests.cpp \
+    src/distance-tests.cpp \
+    src/simplify-tests.cpp \
+    src/nmeaStream-tests.cpp \
+    src/nmeaPipeline-tests.cpp \
+    src/geofence-tests.cpp \
+    src/routeMatcher-tests.cpp \
+    src/routeSums-tests.cpp \
+    src/routeLibrary-tests.cpp \
+    src/routeSnapshot-tests.cpp \
+    src/routeCache-tests.cpp \
+    src/elevationProfile-tests.cpp \
+    src/positionFilter-tests.cpp
 
 INCLUDEPATH += headers/
 
@@ -0,0 +1,45 @@
+TEMPLATE = app
+CONFIG += console c++11 thread
+CONFIG -= app_bundle
+CONFIG -= qt
+
+# Large-input regression tests for the parallel, streaming and prefix-sum fast paths.
+# For sanitizer builds, run "qmake CONFIG+=asan" (AddressSanitizer and UndefinedBehaviorSanitizer)
+# or "qmake CONFIG+=tsan" (ThreadSanitizer).
+asan {
+    CONFIG += sanitizer sanitize_address sanitize_undefined
+}
+tsan {
+    CONFIG += sanitizer sanitize_thread
+}
+
+HEADERS += \
+    headers/distance.h \
+    headers/earth.h \
+    headers/geometry.h \
+    headers/nmeaPipeline.h \
+    headers/nmeaStream.h \
+    headers/parseNMEA.h \
+    headers/position.h \
+    headers/projection.h \
+    headers/ringBuffer.h \
+    headers/routeMatcher.h \
+    headers/routeSums.h \
+    headers/types.h
+
+SOURCES += \
+    src/distance.cpp \
+    src/earth.cpp \
+    src/nmeaPipeline.cpp \
+    src/nmeaStream.cpp \
+    src/parseNMEA.cpp \
+    src/position.cpp \
+    src/routeMatcher.cpp \
+    src/routeSums.cpp \
+    src/stress-tests.cpp
+
+INCLUDEPATH += headers/
+
+TARGET = $$_PRO_FILE_PWD_/execs/stress-tests
+
+LIBS += -lboost_unit_test_framework
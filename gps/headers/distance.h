@@ -0,0 +1,125 @@
+#ifndef DISTANCE_H_181026
+#define DISTANCE_H_181026
+
+#include <cmath>
+#include <vector>
+
+#include "types.h"
+#include "geometry.h"
+#include "earth.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Distance models.
+   *
+   * Each model is a policy class providing a static between() function, which computes
+   * the horizontal distance between two Positions (elevation is ignored).  Algorithms
+   * that measure distance take the model as a template parameter, so the choice between
+   * speed and accuracy is made at compile time and the chosen model is inlined.
+   *
+   * The error bounds below are relative to the WGS-84 ellipsoid.
+   */
+  namespace Distance
+  {
+      /* Equirectangular approximation: treats the short hop as a straight line on a plane
+       * tangent at the mean latitude of the two points.
+       * Compared with Haversine, the additional relative error is below 0.1% for points
+       * less than 50km apart at latitudes within 70 degrees of the equator, but it grows
+       * quickly for long distances and near the poles.  Intended for granularity thinning
+       * of successive GPS fixes, where precision does not matter.
+       */
+      struct Equirectangular
+      {
+          static metres between(const Position & p1, const Position & p2)
+          {
+              const radians lat1 = degToRad(p1.latitude());
+              const radians lat2 = degToRad(p2.latitude());
+              const radians deltaLon = degToRad(normaliseDeg(p2.longitude() - p1.longitude()));
+
+              const double x = deltaLon * std::cos((lat1 + lat2) / 2);
+              const double y = lat2 - lat1;
+              return Earth::meanRadius * std::sqrt(x*x + y*y);
+          }
+      };
+
+      /* Great-circle distance on a sphere of radius Earth::meanRadius.
+       * Accurate to within 0.5% at any distance, the error coming from the Earth's
+       * flattening.
+       * See: http://en.wikipedia.org/wiki/Law_of_haversines
+       */
+      struct Haversine
+      {
+          static metres between(const Position & p1, const Position & p2)
+          {
+              const radians lat1 = degToRad(p1.latitude());
+              const radians lat2 = degToRad(p2.latitude());
+              const radians lon1 = degToRad(p1.longitude());
+              const radians lon2 = degToRad(p2.longitude());
+
+              double h = sinSqr((lat2-lat1)/2) + std::cos(lat1)*std::cos(lat2)*sinSqr((lon2-lon1)/2);
+              return 2 * Earth::meanRadius * std::asin(std::sqrt(h));
+          }
+      };
+
+      /* Geodesic distance on the WGS-84 ellipsoid, using Vincenty's inverse formula.
+       * Accurate to within 1mm.  For nearly antipodal points the iteration may fail to
+       * converge; in that case the Haversine distance is returned instead.
+       * See: https://en.wikipedia.org/wiki/Vincenty%27s_formulae
+       */
+      struct Vincenty
+      {
+          static metres between(const Position &, const Position &);
+      };
+  }
+
+
+  /* The sum of the distances between successive Positions, as measured by the
+   * distance model.
+   */
+  template <typename DistanceModel = Distance::Haversine>
+  metres pathLength(const std::vector<Position> & positions)
+  {
+      metres length = 0;
+      for (std::size_t i = 1; i < positions.size(); ++i)
+      {
+          length += DistanceModel::between(positions[i-1], positions[i]);
+      }
+      return length;
+  }
+
+
+  /* Returns the (ascending) indices of the Positions that remain after discarding every
+   * Position that is closer than "granularity" to its (retained) predecessor, as measured by
+   * the distance model.  The first Position is always retained.  Returning indices allows any
+   * data stored alongside the Positions (e.g. route point names) to be filtered in the same way.
+   */
+  template <typename DistanceModel = Distance::Equirectangular>
+  std::vector<unsigned int> thinnedIndices(const std::vector<Position> & positions, metres granularity)
+  {
+      std::vector<unsigned int> retained;
+      for (unsigned int i = 0; i < positions.size(); ++i)
+      {
+          if (retained.empty() || DistanceModel::between(positions[retained.back()], positions[i]) >= granularity)
+          {
+              retained.push_back(i);
+          }
+      }
+      return retained;
+  }
+
+
+  // Returns the retained Positions, as selected by thinnedIndices().
+  template <typename DistanceModel = Distance::Equirectangular>
+  std::vector<Position> thinToGranularity(const std::vector<Position> & positions, metres granularity)
+  {
+      std::vector<Position> thinned;
+      for (unsigned int i : thinnedIndices<DistanceModel>(positions, granularity))
+      {
+          thinned.push_back(positions[i]);
+      }
+      return thinned;
+  }
+}
+
+#endif
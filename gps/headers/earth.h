@@ -1,27 +1,35 @@
 #ifndef EARTH_H_120218
 #define EARTH_H_120218
 
+#include "geometry.h"
 #include "position.h"
 
 namespace GPS
 {
   namespace Earth
   {
-      extern const Position NorthPole;
-      extern const Position EquatorialMeridian;
-      extern const Position EquatorialAntiMeridian;
-      extern const Position CliftonCampus;
-      extern const Position CityCampus;
-      extern const Position Pontianak;
+      constexpr Position NorthPole = Position(poleLatitude,0,0);
+      constexpr Position EquatorialMeridian = Position(0,0,0);
+      constexpr Position EquatorialAntiMeridian = Position(0,antiMeridianLongitude,0);
+      constexpr Position CliftonCampus = Position(52.91249953,-1.18402513,58);
+      constexpr Position CityCampus = Position(52.9581383,-1.1542364,53);
+      constexpr Position Pontianak = Position(0,109.322134,0);
 
-      extern const metres meanRadius;
-      extern const metres equatorialCircumference;
-      extern const metres polarCircumference;
+      constexpr metres meanRadius = 6371008.8;
+      constexpr metres equatorialCircumference = 40075160;
+      constexpr metres polarCircumference = 40008000;
+
+      // WGS-84 reference ellipsoid.
+      constexpr metres equatorialRadius = 6378137;
+      constexpr double flattening = 1/298.257223563;
+
+      constexpr degrees latitudeSubtendedBy(metres distance)
+      {
+          return (distance / polarCircumference) * fullRotation;
+      }
 
-      degrees latitudeSubtendedBy(metres);
       degrees longitudeSubtendedBy(metres,degrees lat);
   }
 }
 
 #endif
-
@@ -0,0 +1,87 @@
+#ifndef ELEVATIONPROFILE_H_181026
+#define ELEVATIONPROFILE_H_181026
+
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Filters for smoothing an elevation profile.
+   *
+   * MovingAverage:  the mean of the samples in the window.
+   * SavitzkyGolay:  a least-squares quadratic fit over the window, which preserves peaks and
+   *                 troughs better than a moving average.
+   * Kalman:         a steady-state Kalman filter for a random-walk elevation model (i.e. an
+   *                 exponential filter, with the gain of an exponential moving average of the
+   *                 same window), run forwards and then backwards so that it introduces no lag.
+   *
+   * Near the ends of the profile, the window shrinks symmetrically, so that linear slopes are
+   * preserved by the moving average and Savitzky-Golay filters.  (Where the window is only 3
+   * samples wide, Savitzky-Golay reduces to a moving average, as a quadratic would fit exactly.)
+   */
+  enum class ElevationSmoothing { None, MovingAverage, SavitzkyGolay, Kalman };
+
+
+  /* The elevation of a route, resampled at fixed distance intervals along the route and then
+   * smoothed, so that gradients and climbs are not dominated by noise in GPS elevations.
+   *
+   * Distances along the route are measured as for Route::totalLength().  Elevations between
+   * route points are interpolated linearly.  Samples are taken at equal intervals from the start
+   * to the end of the route, with the interval adjusted from the requested step so that it
+   * divides the route length exactly (this avoids a spuriously steep final interval).
+   * A route of zero length (such as that of a stationary receiver) has a single sample, the
+   * mean of its elevations, and no gradients.
+   * Construction takes O(n + m) time, for n route points and m samples; queries take O(m)
+   * time (or O(1) for elevationAt()).
+   */
+  class ElevationProfile
+  {
+    public:
+      /* "window" is the number of samples over which the filter smooths (and is rounded up to
+       * an odd number).
+       * Throws a std::invalid_argument exception if there are no route points, or if the step
+       * is not positive.
+       */
+      ElevationProfile(const std::vector<Position> & routePoints,
+                       metres step,
+                       ElevationSmoothing = ElevationSmoothing::SavitzkyGolay,
+                       unsigned int window = 5);
+
+      // The actual distance between samples.
+      metres step() const;
+
+      // The distance along the route covered by the profile.
+      metres length() const;
+
+      // The smoothed elevation samples.
+      const std::vector<metres> & elevations() const;
+
+      // The smoothed elevation at the specified distance along the route (clamped to the route).
+      metres elevationAt(metres distance) const;
+
+      // The sum of all the positive (>0) height differences between successive samples.
+      metres totalHeightGain() const;
+
+      // The steepest uphill gradient (in degrees) between successive samples.
+      // If the entire profile is downhill, then this is the least steep downhill gradient (i.e. negative).
+      degrees maxGradient() const;
+
+      // The steepest downhill gradient (in degrees) between successive samples.
+      // If the entire profile is uphill, then this is the least steep uphill gradient (i.e. positive).
+      degrees minGradient() const;
+
+      // The steepest gradient (in degrees) between successive samples, whether uphill (positive) or downhill (negative).
+      degrees steepestGradient() const;
+
+    private:
+      metres sampleStep;
+      metres totalLength;
+      std::vector<metres> samples;
+
+      std::vector<degrees> gradients() const;
+  };
+}
+
+#endif
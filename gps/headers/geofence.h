@@ -0,0 +1,115 @@
+#ifndef GEOFENCE_H_181026
+#define GEOFENCE_H_181026
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* A collection of circular and polygonal geofences, indexed for fast containment tests.
+   *
+   * Each fence has an integer bounding box (in units of 10^-7 degrees), and is registered
+   * in every cell of a uniform latitude/longitude grid that its box overlaps.  Testing a
+   * Position therefore only examines the fences registered in a single grid cell, and most
+   * of those are rejected by an integer box comparison before any trigonometry is done.
+   * The cost per Position depends on the local density of fences, not on their total number.
+   *
+   * Fences that would overlap more than 1024 cells (such as country-sized polygons, or circles
+   * around a pole, which cover every longitude) are instead kept in a single list that is
+   * tested for every Position, so that no fence occupies more than a bounded number of cells.
+   *
+   * Fences must not span the anti-meridian.
+   */
+  class GeofenceIndex
+  {
+    public:
+      using FenceId = unsigned int;
+
+      /* "cellSize" is the side length of the grid cells.  It should be comparable to the
+       * size of a typical fence.
+       */
+      explicit GeofenceIndex(degrees cellSize = 0.01);
+
+      /* Add a circular fence, returning its identifier.
+       * Throws a std::invalid_argument exception if the radius is negative, or if the
+       * fence would span the anti-meridian.
+       */
+      FenceId addCircle(const Position & centre, metres radius);
+
+      /* Add a polygonal fence, with the specified vertices in order, returning its identifier.
+       * Throws a std::invalid_argument exception if there are fewer than three vertices, or if
+       * the fence would span the anti-meridian.
+       */
+      FenceId addPolygon(const std::vector<Position> & vertices);
+
+      // The number of fences.
+      unsigned int numFences() const;
+
+      // The identifiers, in ascending order, of all fences containing the Position.
+      std::vector<FenceId> fencesContaining(const Position &) const;
+
+    private:
+      struct Box
+      {
+          std::int32_t minLat, maxLat, minLon, maxLon;
+      };
+
+      struct Fence
+      {
+          Box box;
+          std::vector<Position> vertices; // Polygonal fences only.
+          degrees centreLat, centreLon;   // Circular fences only.
+          metres radius;                  // Negative for polygonal fences.
+      };
+
+      std::int32_t cellSize; // In units of 10^-7 degrees.
+      std::vector<Fence> fences;
+      std::unordered_map<std::uint64_t, std::vector<FenceId>> cells;
+      std::vector<FenceId> largeFences; // Those overlapping too many cells to register in the grid.
+
+      static Box boxOf(degrees minLat, degrees maxLat, degrees minLon, degrees maxLon);
+      FenceId add(Fence);
+      bool contains(const Fence &, const Position &) const;
+      void addContaining(const std::vector<FenceId> & candidates, const Position &,
+                         std::int32_t lat, std::int32_t lon, std::vector<FenceId> & found) const;
+  };
+
+
+  struct GeofenceEvent
+  {
+      enum Type { Enter, Exit };
+
+      unsigned int positionIndex; // Index of the Position (within the batch) at which the event occurred.
+      GeofenceIndex::FenceId fence;
+      Type type;
+  };
+
+
+  /* Tracks which fences a single moving subject (e.g. one GPS receiver) is inside, and
+   * reports when it enters or leaves them.  A GeofenceIndex can be shared by many trackers.
+   * Initially the subject is not inside any fence.
+   */
+  class GeofenceTracker
+  {
+    public:
+      explicit GeofenceTracker(const GeofenceIndex &);
+
+      /* Process a batch of successive Positions, returning the resulting events in order.
+       * Within a single Position, exits are reported before entries.
+       */
+      std::vector<GeofenceEvent> update(const std::vector<Position> &);
+
+      // The identifiers, in ascending order, of the fences the subject is currently inside.
+      const std::vector<GeofenceIndex::FenceId> & currentFences() const;
+
+    private:
+      const GeofenceIndex & index;
+      std::vector<GeofenceIndex::FenceId> inside;
+  };
+}
+
+#endif
@@ -1,27 +1,48 @@
 #ifndef GEOMETRY_H_211217
 #define GEOMETRY_H_211217
 
+#include <cmath>
+
 #include "types.h"
 
 namespace GPS
 {
-  extern const double pi;
-  extern const degrees fullRotation;
-  extern const degrees halfRotation;
-  extern const degrees poleLatitude;
-  extern const degrees antiMeridianLongitude;
+  /* These constants and conversions are defined here, rather than in a separate
+   * translation unit, so that they can be folded into the callers' arithmetic.
+   */
+  constexpr double pi = 3.141592653589793;
+  constexpr degrees fullRotation = 360;
+  constexpr degrees halfRotation = fullRotation/2;
+  constexpr degrees poleLatitude = fullRotation/4;
+  constexpr degrees antiMeridianLongitude = fullRotation/2;
 
   // Convert from degrees to radians.
-  radians degToRad(degrees);
+  constexpr radians degToRad(degrees d)
+  {
+      return d * pi / halfRotation;
+  }
 
   // Convert from radians to degrees.
-  radians radToDeg(degrees);
+  constexpr degrees radToDeg(radians r)
+  {
+      return r * halfRotation / pi;
+  }
 
   // Sine squared function: sin^2(x)
-  double sinSqr(radians);
+  inline double sinSqr(radians x)
+  {
+      const double sx = std::sin(x);
+      return sx * sx;
+  }
 
   // Ensure degrees are in (-180,180] range.
-  degrees normaliseDeg(degrees);
+  inline degrees normaliseDeg(degrees d)
+  {
+      d = std::fmod(d,fullRotation); // results in range (-360,360)
+      if (d <= -halfRotation) d += fullRotation; // results in range (-180,360)
+      if (d > halfRotation) d -= fullRotation; // results in range (-180,180]
+      return d;
+  }
 }
 
 #endif
@@ -0,0 +1,28 @@
+#ifndef NMEAPIPELINE_H_181026
+#define NMEAPIPELINE_H_181026
+
+#include <string>
+#include <vector>
+
+#include "position.h"
+
+namespace GPS
+{
+  /* Equivalent to routeFromNMEALog(), but split into five pipelined stages, each on its own
+   * thread:
+   *   read -> validate -> decode -> extract -> accumulate
+   * Stages are connected by bounded lock-free ring buffers, and pass sentences in batches,
+   * so a slow stage holds back its upstream stages rather than buffering without limit.
+   *
+   * "stageCores" optionally pins each stage (in the order above) to a CPU core; a negative
+   * entry, or a missing one, leaves that stage unpinned.  Pinning is only supported on Linux,
+   * and is silently skipped elsewhere or if it fails.
+   *
+   * The result is identical to that of routeFromNMEALog().  If any stage throws, the other
+   * stages are wound down, and the first exception is rethrown once they have all finished.
+   */
+  std::vector<Position> routeFromNMEALogPipelined(const std::string & filepath,
+                                                  const std::vector<int> & stageCores = {});
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef NMEASTREAM_H_181026
+#define NMEASTREAM_H_181026
+
+#include <string>
+#include <functional>
+#include <map>
+#include <memory>
+#include <cstddef>
+
+#include "position.h"
+#include "parseNMEA.h"
+
+namespace GPS
+{
+  /* Incrementally extracts Positions from a stream of NMEA sentences (one per line), such
+   * as a pipe or a (pseudo-)terminal connected to a GPS receiver.
+   *
+   * Bytes are supplied as they arrive, in chunks of any size; a sentence split across
+   * chunks is reassembled.  Each complete line is validated and decoded in the same way
+   * as routeFromNMEALog(), and the handler is called for every Position extracted (or for
+   * every NMEAFix, for handlers that need to know which fixes have elevations, or which
+   * come from the same epoch).
+   * Blank lines, invalid sentences and unsupported sentence types are ignored.
+   */
+  class NMEAStreamReader
+  {
+    public:
+      using PositionHandler = std::function<void(const Position &)>;
+      using FixHandler = std::function<void(const NMEAFix &)>;
+
+      /* Lines longer than this are discarded, so that a stream of garbage cannot grow the
+       * buffer without limit.  Valid NMEA sentences are at most 82 characters.
+       */
+      static const std::size_t maxLineLength = 1024;
+
+      explicit NMEAStreamReader(PositionHandler);
+      explicit NMEAStreamReader(FixHandler);
+
+      // Process a chunk of bytes from the stream.
+      void consume(const char * data, std::size_t length);
+
+      // Process any final, unterminated line at the end of the stream.
+      void finish();
+
+      /* Read whatever is currently available from a file descriptor.  A non-blocking
+       * descriptor is read until it would block; a blocking descriptor is read to the end.
+       * Returns false once the end of the stream has been reached (after calling finish()).
+       * Throws a std::system_error exception if the read fails.
+       */
+      bool readFrom(int fileDescriptor);
+
+    private:
+      FixHandler handler;
+      std::string partialLine;
+      bool discarding = false; // Currently skipping an over-long line?
+
+      void processLine(const char * begin, const char * end);
+  };
+
+
+  /* Multiplexes many NMEA streams onto one thread, using epoll (Linux only).
+   * Each registered file descriptor has its own NMEAStreamReader.  Descriptors should be
+   * non-blocking.  A descriptor is deregistered (but not closed) when it reaches the end
+   * of its stream.
+   */
+  class NMEAStreamPoller
+  {
+    public:
+      // Throws a std::system_error exception if an epoll instance cannot be created.
+      NMEAStreamPoller();
+      ~NMEAStreamPoller();
+
+      NMEAStreamPoller(const NMEAStreamPoller &) = delete;
+      NMEAStreamPoller & operator=(const NMEAStreamPoller &) = delete;
+
+      // Throws a std::system_error exception if the descriptor cannot be registered.
+      void add(int fileDescriptor, NMEAStreamReader::PositionHandler);
+      void add(int fileDescriptor, NMEAStreamReader::FixHandler);
+
+      // The number of registered descriptors that have not yet reached the end of their streams.
+      std::size_t numStreams() const;
+
+      /* Waits up to "timeout" milliseconds (-1 for no limit) for data on any registered
+       * descriptor, and processes everything available.
+       * Returns the number of descriptors that were serviced.
+       */
+      unsigned int poll(int timeout);
+
+    private:
+      int epollDescriptor;
+      std::map<int, std::unique_ptr<NMEAStreamReader>> readers;
+
+      void addReader(int fileDescriptor, NMEAStreamReader *);
+      void remove(int fileDescriptor);
+  };
+}
+
+#endif
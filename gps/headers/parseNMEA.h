@@ -19,11 +19,26 @@ namespace GPS
   using NMEAPair = std::pair<std::string, std::vector<std::string>>;
 
 
+  /* The sentence formats recognised by this parser.
+   * Only GLL, GGA and RMC sentences contain a position; VTG and RMC contain the course and
+   * speed; GSA contains the dilution of precision; and GSV contains the satellites in view.
+   */
+  enum class SentenceFormat { GLL, GGA, RMC, VTG, GSA, GSV, Unsupported };
+
+
+  /* Determine the format of a NMEA sentence type (excluding the '$'), e.g. "GNRMC".
+   * Returns SentenceFormat::Unsupported for unrecognised formats or talker IDs.
+   */
+  SentenceFormat sentenceFormat(const std::string & sentenceType);
+
+
   /* Determine whether the parameter is a valid NMEA sentence, including verifying
    * the checksum.
    *
    * A NMEA sentence consists of:
-   *   - the prefix "$GP";
+   *   - the prefix '$';
+   *   - followed by a two-character talker ID, which must be one of "GP" (GPS),
+   *     "GN" (combined GNSS), "GL" (GLONASS), "GA" (Galileo) or "GB" (BeiDou);
    *   - followed by a three-character identifier for the sentence format;
    *   - followed by a sequence of comma-separated fields;
    *   - followed by a '*' character;
@@ -46,12 +61,81 @@ namespace GPS
 
 
   /* Computes a Position from a NMEAPair.
-   * For ill-formed or unsupported sentence types, throws a std::invalid_argument
-   * exception.
+   * For ill-formed sentences, or sentence types that do not contain a position, throws a
+   * std::invalid_argument exception.
    */
   Position extractPosition(const NMEAPair &);
 
 
+  // A Position extracted from a NMEA sentence, with what the sentence says about its provenance.
+  struct NMEAFix
+  {
+      Position position;
+      bool hasElevation; // GLL and RMC sentences have no elevation field, so their elevation is 0.
+      double timeOfDay;  // Seconds since midnight (UTC), or -1 if the sentence has no usable time.
+  };
+
+  /* Computes a NMEAFix from a NMEAPair.
+   * Sentences of different types from the same epoch (e.g. a GGA and a RMC) have the same
+   * time of day.  An absent or ill-formed time field is not an error.
+   * For ill-formed sentences, or sentence types that do not contain a position, throws a
+   * std::invalid_argument exception.
+   */
+  NMEAFix extractFix(const NMEAPair &);
+
+
+  // The course and speed over the ground, from VTG or RMC sentences.
+  struct CourseOverGround
+  {
+      degrees course; // Relative to true North.
+      speed knots;
+  };
+
+  /* Computes the course and speed from a NMEAPair.
+   * For ill-formed sentences, or sentence types other than VTG and RMC, throws a
+   * std::invalid_argument exception.
+   */
+  CourseOverGround extractCourse(const NMEAPair &);
+
+
+  // The fix type and dilutions of precision, from GSA sentences.
+  struct DilutionOfPrecision
+  {
+      unsigned int fixType; // 1 = no fix, 2 = 2D, 3 = 3D.
+      double position;
+      double horizontal;
+      double vertical;
+  };
+
+  /* Computes the fix type and dilutions of precision from a NMEAPair.
+   * For ill-formed sentences, or sentence types other than GSA, throws a
+   * std::invalid_argument exception.
+   */
+  DilutionOfPrecision extractDilution(const NMEAPair &);
+
+
+  // A satellite in view, from GSV sentences.
+  struct SatelliteInfo
+  {
+      unsigned int id;
+      degrees elevation;
+      degrees azimuth;
+      int signalToNoise; // dB-Hz, or -1 if the satellite is not being tracked.
+  };
+
+  struct SatellitesInView
+  {
+      unsigned int numSatellites;             // In view in total, over all the GSV sentences in the sequence.
+      std::vector<SatelliteInfo> satellites;  // Described by this sentence (at most 4).
+  };
+
+  /* Computes the satellites in view from a NMEAPair.
+   * For ill-formed sentences, or sentence types other than GSV, throws a
+   * std::invalid_argument exception.
+   */
+  SatellitesInView extractSatellites(const NMEAPair &);
+
+
   /* Pre-condition: The parameter is the filepath of a file containing NMEA sentences
    * (one per line).
    * Reads the file, and returns a vector of Positions extracted from the sentences.
@@ -2,8 +2,10 @@
 #define POSITION_H_211217
 
 #include <string>
+#include <stdexcept>
 
 #include "types.h"
+#include "geometry.h"
 
 namespace GPS
 {
@@ -13,8 +15,10 @@ namespace GPS
 
       /* Construct a Position from degrees latitude, degrees longitude, and
        * (optionally) elevation in metres.
+       * Throws a std::invalid_argument exception if either angle is out of range.
        */
-      Position(degrees lat, degrees lon, metres ele = 0.0);
+      constexpr Position(degrees lat, degrees lon, metres ele = 0.0)
+          : lat(checkedLatitude(lat)), lon(checkedLongitude(lon)), ele(ele) {}
 
 
       /* Construct a Position from strings containing a decimal degrees
@@ -35,14 +39,15 @@ namespace GPS
                const std::string & ddmLonStr, char easting,
                const std::string & eleSt = "0");
 
-      degrees latitude() const;
-      degrees longitude() const;
-      metres  elevation() const;
+      constexpr degrees latitude() const { return lat; }
+      constexpr degrees longitude() const { return lon; }
+      constexpr metres  elevation() const { return ele; }
 
       std::string toString(bool includeElevation = true) const;
 
       /* Computes an approximation of the distance between two Positions on the Earth's surface.
        * Does not take into account elevation.
+       * This uses the Distance::Haversine model; see distance.h for alternatives.
        */
       static metres distanceBetween(const Position &, const Position &);
 
@@ -50,6 +55,20 @@ namespace GPS
       degrees lat;
       degrees lon;
       metres  ele;
+
+      static constexpr degrees checkedLatitude(degrees lat)
+      {
+          return (lat > poleLatitude || lat < -poleLatitude)
+                 ? throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.")
+                 : lat;
+      }
+
+      static constexpr degrees checkedLongitude(degrees lon)
+      {
+          return (lon > antiMeridianLongitude || lon < -antiMeridianLongitude)
+                 ? throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.")
+                 : lon;
+      }
   };
 
 
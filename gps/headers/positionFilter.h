@@ -0,0 +1,122 @@
+#ifndef POSITIONFILTER_H_181026
+#define POSITIONFILTER_H_181026
+
+#include <functional>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+#include "projection.h"
+#include "parseNMEA.h"
+#include "nmeaStream.h"
+
+namespace GPS
+{
+  // A Position smoothed by a PositionFilter, and whether the receiver appears to be stationary.
+  struct FilteredPosition
+  {
+      Position position;
+      bool stationary;
+      bool sameEpoch; // Did the fix refine the estimate for the previous fix's epoch, rather than start a new one?
+  };
+
+
+  /* Smooths a stream of fixes from one receiver with a constant-velocity Kalman filter.
+   *
+   * Horizontal position is filtered in a local plane about a recent fix (the origin is moved
+   * whenever the receiver strays more than a few kilometres from it); elevation is filtered
+   * separately, as receivers report it far less accurately.  Fixes from sentences without an
+   * elevation field (GLL and RMC) do not affect the elevation estimate.
+   *
+   * Time steps are the differences between the fixes' times of day (allowing for midnight),
+   * so gaps in reception widen the uncertainty accordingly; fixes without a time of day (such
+   * as bare Positions) are taken to be one second apart.  Speeds are in metres per second.
+   * Successive fixes from the same epoch (i.e. with the same time of day, such as a GGA and a
+   * RMC sentence) refine the same estimate, rather than counting as a time step.  Each update
+   * is a few dozen arithmetic operations with no allocation, and a filter is small enough to
+   * keep one per stream for thousands of streams.
+   *
+   * The receiver is considered stationary while its estimated horizontal speed is below the
+   * "stationarySpeed" threshold.
+   */
+  class PositionFilter
+  {
+    public:
+      using FilteredPositionHandler = std::function<void(const FilteredPosition &)>;
+
+      /* "measurementNoise" and "verticalNoise" are the standard deviations of the receiver's
+       * horizontal and vertical errors; "accelerationNoise" is the standard deviation of the
+       * receiver's acceleration (in metres per second per second).
+       * Throws a std::invalid_argument exception if any of these is not positive.
+       */
+      explicit PositionFilter(metres measurementNoise = 5,
+                              metres accelerationNoise = 0.25,
+                              metres verticalNoise = 10,
+                              metres stationarySpeed = 0.5);
+
+      // Incorporates the next fix, and returns the smoothed position.
+      FilteredPosition update(const NMEAFix &);
+
+      // As above, for a fix with an elevation and no time of day.
+      FilteredPosition update(const Position &);
+
+      // Forgets all previous fixes, e.g. after the receiver loses its fix.
+      void reset();
+
+      // The number of epochs incorporated since construction or the last reset().
+      unsigned int numFixes() const;
+
+    private:
+      // A symmetric 2x2 covariance matrix, for the position and speed along one axis.
+      struct Covariance
+      {
+          double pp, pv, vv;
+      };
+
+      // The estimated position and speed along one axis.
+      struct AxisState
+      {
+          metres position, speed;
+      };
+
+      double horizontalVariance, accelerationVariance, verticalVariance;
+      metres stationarySpeed;
+
+      unsigned int fixes = 0;
+      double epochTime = -1;
+      bool epochHasElevation = false;
+      bool hasElevation = false; // Has any fix had an elevation?
+      LocalProjection projection;
+      AxisState east, north, up;
+      Covariance horizontal, vertical; // East and North share the same model, so share a covariance.
+
+      void start(const NMEAFix &);
+      void correctElevation(metres);
+      FilteredPosition estimate(bool sameEpoch);
+
+      static Covariance predict(const Covariance &, double timeStep, double accelerationVariance);
+      static void correct(AxisState &, metres measured, double gain0, double gain1);
+      static void correct(Covariance &, double gain0, double gain1);
+  };
+
+
+  /* Returns a handler for NMEAStreamReader (or NMEAStreamPoller) that passes each fix
+   * through the filter before calling "handler".
+   */
+  NMEAStreamReader::FixHandler filteredHandler(PositionFilter::FilteredPositionHandler handler,
+                                               PositionFilter filter = PositionFilter());
+
+
+  /* Smooths a sequence of fixes, merging fixes from the same epoch and discarding all but the
+   * first of each run of stationary fixes, so that a receiver jittering in place does not
+   * accumulate distance.
+   */
+  std::vector<Position> filterRoute(const std::vector<NMEAFix> & fixes,
+                                    PositionFilter filter = PositionFilter());
+
+  // As above, for fixes that all have elevations, each from a new epoch.
+  std::vector<Position> filterRoute(const std::vector<Position> & fixes,
+                                    PositionFilter filter = PositionFilter());
+}
+
+#endif
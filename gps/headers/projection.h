@@ -0,0 +1,82 @@
+#ifndef PROJECTION_H_181026
+#define PROJECTION_H_181026
+
+#include <cmath>
+
+#include "types.h"
+#include "geometry.h"
+#include "earth.h"
+#include "position.h"
+
+namespace GPS
+{
+  // A point on a plane, in metres East (x) and North (y) of some origin.
+  struct PlanePoint
+  {
+      metres x;
+      metres y;
+  };
+
+
+  /* An equirectangular projection onto a plane tangent to the Earth at the origin.
+   * Distances in the plane agree with Distance::Equirectangular, so the projection is
+   * suitable for geometry over a region a few tens of kilometres across (e.g. a Route),
+   * but not for continental scales.
+   */
+  class LocalProjection
+  {
+    public:
+      explicit LocalProjection(const Position & origin)
+          : origin(origin),
+            metresPerRadianLon(Earth::meanRadius * std::cos(degToRad(origin.latitude()))) {}
+
+      PlanePoint toPlane(const Position & pos) const
+      {
+          return { metresPerRadianLon * degToRad(normaliseDeg(pos.longitude() - origin.longitude())),
+                   Earth::meanRadius * degToRad(pos.latitude() - origin.latitude()) };
+      }
+
+      Position fromPlane(const PlanePoint & p, metres ele = 0) const
+      {
+          const degrees lon = (metresPerRadianLon == 0) ? origin.longitude()
+                              : origin.longitude() + radToDeg(p.x / metresPerRadianLon);
+          return Position(origin.latitude() + radToDeg(p.y / Earth::meanRadius), normaliseDeg(lon), ele);
+      }
+
+    private:
+      Position origin;
+      metres metresPerRadianLon;
+  };
+
+
+  // The Euclidean distance between two points in the plane.
+  inline metres planeDistance(const PlanePoint & p1, const PlanePoint & p2)
+  {
+      return std::hypot(p2.x - p1.x, p2.y - p1.y);
+  }
+
+
+  /* The fraction (in [0,1]) of the way along the segment from "start" to "end" at which
+   * the closest point to "p" lies.
+   */
+  inline double closestFractionAlong(const PlanePoint & p, const PlanePoint & start, const PlanePoint & end)
+  {
+      const double dx = end.x - start.x;
+      const double dy = end.y - start.y;
+      const double lengthSqr = dx*dx + dy*dy;
+      if (lengthSqr == 0) return 0; // Degenerate segment.
+
+      const double t = ((p.x - start.x) * dx + (p.y - start.y) * dy) / lengthSqr;
+      return (t < 0) ? 0 : (t > 1) ? 1 : t;
+  }
+
+
+  // The distance from "p" to the closest point on the segment from "start" to "end".
+  inline metres distanceToSegment(const PlanePoint & p, const PlanePoint & start, const PlanePoint & end)
+  {
+      const double t = closestFractionAlong(p, start, end);
+      return planeDistance(p, { start.x + t * (end.x - start.x), start.y + t * (end.y - start.y) });
+  }
+}
+
+#endif
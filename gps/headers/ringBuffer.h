@@ -0,0 +1,88 @@
+#ifndef RINGBUFFER_H_181026
+#define RINGBUFFER_H_181026
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace GPS
+{
+  /* A bounded, lock-free, single-producer single-consumer queue.
+   *
+   * Exactly one thread may push, and exactly one (other) thread may pop.  The producer
+   * and consumer indices live on separate cache lines, and each side keeps a cached copy
+   * of the other's index, so that in the steady state neither side touches the other's
+   * cache line.  The capacity must be a power of two.
+   */
+  template <typename T, std::size_t Capacity>
+  class SPSCRingBuffer
+  {
+      static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+    public:
+      SPSCRingBuffer() : slots(Capacity) {}
+
+      SPSCRingBuffer(const SPSCRingBuffer &) = delete;
+      SPSCRingBuffer & operator=(const SPSCRingBuffer &) = delete;
+
+      // Producer only.  Moves from the item and returns true, unless the buffer is full.
+      bool tryPush(T & item)
+      {
+          const std::size_t tail = tailIndex.load(std::memory_order_relaxed);
+          if (tail - cachedHead == Capacity)
+          {
+              cachedHead = headIndex.load(std::memory_order_acquire);
+              if (tail - cachedHead == Capacity) return false;
+          }
+          slots[tail & mask] = std::move(item);
+          tailIndex.store(tail + 1, std::memory_order_release);
+          return true;
+      }
+
+      // Producer only.  Waits while the buffer is full, so a slow consumer applies back-pressure.
+      void push(T item)
+      {
+          while (!tryPush(item)) std::this_thread::yield();
+      }
+
+      // Consumer only.  Moves the oldest item out and returns true, unless the buffer is empty.
+      bool tryPop(T & item)
+      {
+          const std::size_t head = headIndex.load(std::memory_order_relaxed);
+          if (head == cachedTail)
+          {
+              cachedTail = tailIndex.load(std::memory_order_acquire);
+              if (head == cachedTail) return false;
+          }
+          item = std::move(slots[head & mask]);
+          headIndex.store(head + 1, std::memory_order_release);
+          return true;
+      }
+
+      // Consumer only.  Waits while the buffer is empty.
+      T pop()
+      {
+          T item;
+          while (!tryPop(item)) std::this_thread::yield();
+          return item;
+      }
+
+    private:
+      static const std::size_t cacheLineSize = 64;
+      static const std::size_t mask = Capacity - 1;
+
+      std::vector<T> slots;
+
+      // Written by the consumer.
+      alignas(cacheLineSize) std::atomic<std::size_t> headIndex {0};
+      std::size_t cachedTail = 0;
+
+      // Written by the producer.
+      alignas(cacheLineSize) std::atomic<std::size_t> tailIndex {0};
+      std::size_t cachedHead = 0;
+  };
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef ROUTECACHE_H_181026
+#define ROUTECACHE_H_181026
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "types.h"
+#include "route.h"
+#include "routeSnapshot.h"
+
+namespace GPS
+{
+  /* A thread-safe, size-bounded, least-recently-used cache of routes loaded from files.
+   *
+   * Entries are keyed by canonical file path and granularity, so the same file reached
+   * through different paths (via symbolic links, or "." and ".." components) is cached once.
+   * They record the file's size and modification time, so a file that changes on disk is
+   * reloaded (replacing the stale entry) rather than served stale.
+   * The size of an entry is the memory occupied by its route data and its path; when the
+   * total exceeds the capacity, the least recently used entries are evicted.
+   *
+   * Cached routes are immutable RouteSnapshots, so a hit returns a shared reference to the
+   * cached data rather than a copy.  Loading happens outside the cache's lock, so a slow load
+   * does not delay hits on other routes.
+   */
+  class RouteCache
+  {
+    public:
+      using Loader = std::function<RouteSnapshot(const std::string & filepath, metres granularity)>;
+
+      RouteCache(std::size_t capacityBytes, Loader);
+
+      RouteCache(const RouteCache &) = delete;
+      RouteCache & operator=(const RouteCache &) = delete;
+
+      /* Returns the route loaded from the file at the specified granularity, using the cached
+       * copy if the file is unchanged.  If the file cannot be examined, the loader is called
+       * directly (and may throw), and the result is not cached.
+       */
+      RouteSnapshot get(const std::string & filepath, metres granularity);
+
+      // Discards all cached routes.
+      void clear();
+
+      std::size_t capacityBytes() const;
+      std::size_t sizeBytes() const;
+      unsigned int numEntries() const;
+
+      // The number of calls to get() that were (or were not) served from the cache.
+      unsigned long hits() const;
+      unsigned long misses() const;
+
+      /* The process-wide cache of GPX routes, constructed with Route(filepath, true, granularity)
+       * and copied through its public interface.
+       */
+      static RouteCache & instance();
+
+    private:
+      struct Key
+      {
+          std::string filepath;
+          metres granularity;
+
+          bool operator==(const Key &) const;
+      };
+
+      // Identifies the version of a file.
+      struct FileStamp
+      {
+          long long size;
+          long long modifiedTime; // Nanoseconds, where the platform provides them.
+
+          bool operator==(const FileStamp &) const;
+      };
+
+      struct KeyHash
+      {
+          std::size_t operator()(const Key &) const;
+      };
+
+      struct Entry
+      {
+          const Key * key; // Stored in the index, whose nodes do not move.
+          FileStamp stamp;
+          RouteSnapshot route;
+          std::size_t bytes;
+      };
+
+      const std::size_t capacity;
+      const Loader loader;
+
+      mutable std::mutex mutex;
+      std::list<Entry> entries; // Most recently used first.
+      std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+      std::size_t totalBytes = 0;
+      unsigned long numHits = 0;
+      unsigned long numMisses = 0;
+
+      void erase(std::list<Entry>::iterator);
+      void evictToFit();
+  };
+
+
+  inline RouteCache & RouteCache::instance()
+  {
+      static RouteCache cache(64 * 1024 * 1024, [](const std::string & filepath, metres granularity)
+      {
+          const Route route(filepath, true, granularity);
+          std::vector<Position> positions;
+          std::vector<std::string> positionNames;
+          for (unsigned int i = 0; i < route.numPositions(); ++i)
+          {
+              positions.push_back(route[i]);
+              positionNames.push_back(route.findNameOf(positions.back()));
+          }
+          return RouteSnapshot(route.name(), std::move(positions), std::move(positionNames), granularity);
+      });
+      return cache;
+  }
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef ROUTELIBRARY_H_181026
+#define ROUTELIBRARY_H_181026
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* The discrete Frechet distance between two routes: the smallest "leash length" that lets
+   * two walkers traverse the routes' points, in order and without backtracking.
+   * Distances are measured with Distance::Equirectangular.  Takes O(nm) time and O(m) space.
+   * Throws a std::invalid_argument exception if either route is empty.
+   */
+  metres discreteFrechetDistance(const std::vector<Position> &, const std::vector<Position> &);
+
+
+  /* A library of routes, indexed for near-duplicate search.
+   *
+   * Two routes are similar if they follow each other to within "granularity" metres; that is,
+   * if their discrete Frechet distance (after resampling both routes at intervals of half
+   * the granularity) does not exceed the granularity.
+   *
+   * Each route is fingerprinted by the set of geohash cells that it passes through (including
+   * neighbouring cells, so that routes near cell boundaries still share cells).  The set is
+   * summarised by a MinHash signature, which is split into bands for locality-sensitive
+   * hashing.  A search only examines routes that share at least one band with the query, so
+   * its cost grows with the number of similar routes rather than with the size of the library.
+   * Each candidate is then verified with the Frechet distance.
+   *
+   * The index is probabilistic: a genuinely similar route is missed only if none of its bands
+   * match, which for near-duplicates (with most cells in common) is very unlikely.
+   */
+  class RouteLibrary
+  {
+    public:
+      using RouteId = unsigned int;
+
+      /* Signatures have numBands * rowsPerBand hash values.  More bands find less similar
+       * candidates; more rows per band make candidates more selective.
+       */
+      explicit RouteLibrary(metres granularity = 20, unsigned int numBands = 16, unsigned int rowsPerBand = 4);
+
+      /* Add a route, returning its identifier.
+       * Throws a std::invalid_argument exception if the route is empty.
+       */
+      RouteId add(const std::vector<Position> &);
+
+      unsigned int numRoutes() const;
+
+      /* The identifiers (in ascending order) of stored routes that might be similar to the route.
+       * Throws a std::invalid_argument exception if the route is empty.
+       */
+      std::vector<RouteId> candidates(const std::vector<Position> &) const;
+
+      /* The identifiers (in ascending order) of stored routes that are similar to the route.
+       * Throws a std::invalid_argument exception if the route is empty.
+       */
+      std::vector<RouteId> findSimilar(const std::vector<Position> &) const;
+
+    private:
+      using Signature = std::vector<std::uint64_t>;
+
+      metres granularity;
+      unsigned int numBands;
+      unsigned int rowsPerBand;
+      unsigned int geohashBits; // Precision of the geohash cells, per axis.
+
+      std::vector<std::vector<Position>> routes; // Resampled for verification.
+      std::unordered_map<std::uint64_t, std::vector<RouteId>> buckets; // Band hash -> routes.
+
+      std::vector<Position> resampled(const std::vector<Position> &, metres interval) const;
+      Signature signatureOf(const std::vector<Position> &) const;
+      std::uint64_t bandHash(const Signature &, unsigned int band) const;
+  };
+}
+
+#endif
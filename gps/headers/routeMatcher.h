@@ -0,0 +1,78 @@
+#ifndef ROUTEMATCHER_H_181026
+#define ROUTEMATCHER_H_181026
+
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+#include "projection.h"
+#include "routeSums.h"
+
+namespace GPS
+{
+  struct RouteMatch
+  {
+      Position closest;     // The closest point on the route (elevation interpolated).
+      metres distance;      // The distance from the query Position to the closest point.
+      metres alongRoute;    // The distance along the route from its start to the closest point.
+      unsigned int segment; // The closest point lies between route points "segment" and "segment+1".
+  };
+
+
+  /* Matches Positions to the closest point on a route, taking into account the whole of each
+   * segment between successive route points, not just the route points themselves.
+   *
+   * The segments are held in a packed R-tree (bulk loaded by Sort-Tile-Recursive), which is
+   * searched best-first, so a query takes O(log n) time for typical routes.  Cumulative
+   * distances along the route are precomputed, so the along-route distance of a match
+   * costs nothing extra.
+   *
+   * Geometry is computed on a LocalProjection centred on the route, so routes should be no
+   * more than a few hundred kilometres across (but may cross the anti-meridian).  Along-route
+   * distances are measured in the same way as totalLength() (i.e. with
+   * Position::distanceBetween()).
+   */
+  class RouteMatcher
+  {
+    public:
+      // Throws a std::invalid_argument exception if there are no route points.
+      explicit RouteMatcher(const std::vector<Position> & routePoints);
+
+      // If several points on the route are equally close, any one of them may be returned.
+      RouteMatch closestPoint(const Position &) const;
+
+      // The total length of the route.
+      metres length() const;
+
+    private:
+      struct Rect
+      {
+          metres minX, minY, maxX, maxY;
+      };
+
+      struct Node
+      {
+          Rect box;
+          unsigned int firstChild; // Index into "children".
+          unsigned int numChildren;
+          bool isLeaf;             // Are the children segments (rather than nodes)?
+      };
+
+      std::vector<Position> routePoints;
+      LocalProjection projection;
+      std::vector<PlanePoint> points;
+      RouteSums sums;
+
+      std::vector<Node> nodes;
+      std::vector<unsigned int> children;
+      unsigned int root;
+
+      static const unsigned int nodeCapacity = 16;
+
+      void buildTree();
+      Rect segmentBox(unsigned int segment) const;
+      static metres distanceSqr(const PlanePoint &, const Rect &);
+  };
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef ROUTESNAPSHOT_H_181026
+#define ROUTESNAPSHOT_H_181026
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* An immutable snapshot of a Route's name, route points and granularity.
+   *
+   * Snapshots share their storage: copying one only copies a reference-counted pointer,
+   * so snapshots can be passed between threads and held in caches without deep copies.
+   * Because the shared data is never modified, any number of threads may read the same
+   * snapshot concurrently without locking.  "Modifying" a snapshot produces a new one.
+   */
+  class RouteSnapshot
+  {
+    public:
+      /* Construct a snapshot from route data.
+       * Throws a std::invalid_argument exception if the name and position vectors differ in size.
+       */
+      RouteSnapshot(std::string routeName,
+                    std::vector<Position> positions,
+                    std::vector<std::string> positionNames,
+                    metres granularity);
+
+      // Returns the name of the Route, or "Unnamed Route" if nameless.
+      std::string name() const;
+
+      // Returns the number of stored route points.
+      unsigned int numPositions() const;
+
+      // Return the route point at the specified index.
+      // Throws a std::out_of_range exception if out-of-range.
+      Position operator[](unsigned int) const;
+
+      // The name of the route point at the specified index (empty if unnamed).
+      // Throws a std::out_of_range exception if out-of-range.
+      const std::string & positionName(unsigned int) const;
+
+      const std::vector<Position> & positions() const;
+
+      metres granularity() const;
+
+      /* Returns a new snapshot, in which any position that differs in distance from its
+       * predecessor by less than the specified granularity is discarded (as with
+       * Route::setGranularity()).  This snapshot is unchanged.
+       */
+      RouteSnapshot withGranularity(metres) const;
+
+      // The memory occupied by the shared route data, in bytes.
+      std::size_t storageBytes() const;
+
+      // Do the two snapshots share the same storage?
+      bool sharesStorageWith(const RouteSnapshot &) const;
+
+    private:
+      struct Data
+      {
+          std::string routeName;
+          std::vector<Position> positions;
+          std::vector<std::string> positionNames;
+          metres granularity;
+      };
+
+      std::shared_ptr<const Data> data;
+  };
+}
+
+#endif
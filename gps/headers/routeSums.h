@@ -0,0 +1,65 @@
+#ifndef ROUTESUMS_H_181026
+#define ROUTESUMS_H_181026
+
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Prefix sums of the segment lengths and positive height gains along a route, so that the
+   * length or climb of any sub-route takes O(1) time, and finding the route point at a given
+   * distance along the route takes O(log n) time.
+   *
+   * Lengths are measured with Position::distanceBetween() and height gains ignore downhill
+   * changes, matching Route::totalLength() and Route::totalHeightGain().  Results agree with
+   * summing the segments directly to within floating-point rounding.
+   *
+   * The sums are computed once on construction; rebuild them if the route is re-thinned.
+   */
+  class RouteSums
+  {
+    public:
+      explicit RouteSums(const std::vector<Position> & routePoints);
+
+      // Returns the number of route points.
+      unsigned int numPositions() const;
+
+      /* The length of the sub-route between the route points at the specified indices.
+       * Throws a std::out_of_range exception if either index is out-of-range, or a
+       * std::invalid_argument exception if "from" is after "to".
+       */
+      metres length(unsigned int from, unsigned int to) const;
+
+      /* The sum of the positive height differences in the sub-route between the route points
+       * at the specified indices.
+       * Throws a std::out_of_range exception if either index is out-of-range, or a
+       * std::invalid_argument exception if "from" is after "to".
+       */
+      metres heightGain(unsigned int from, unsigned int to) const;
+
+      // The length of the whole route.
+      metres totalLength() const;
+
+      // The positive height gain of the whole route.
+      metres totalHeightGain() const;
+
+      /* The index of the last route point that is no further than "distance" along the route.
+       * Distances beyond the end of the route give the last route point.
+       * Throws a std::out_of_range exception if there are no route points.
+       */
+      unsigned int indexAtDistance(metres distance) const;
+
+      // The distance along the route to each route point.
+      const std::vector<metres> & cumulativeLengths() const;
+
+    private:
+      std::vector<metres> lengthSums;
+      std::vector<metres> heightGainSums;
+
+      void checkRange(unsigned int from, unsigned int to) const;
+  };
+}
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SIMPLIFY_H_181026
+#define SIMPLIFY_H_181026
+
+#include <vector>
+
+#include "types.h"
+#include "position.h"
+
+namespace GPS
+{
+  /* Shape-preserving route simplification algorithms.
+   *
+   * DouglasPeucker guarantees that every discarded Position lies within the tolerance
+   * of the simplified route.  It runs in O(n log n) time for typical routes, O(n^2) in
+   * the worst case.
+   *
+   * VisvalingamWhyatt repeatedly discards the Position that deviates least from the line
+   * joining its neighbours, until every remaining deviation exceeds the tolerance.  It
+   * always runs in O(n log n) time, and tends to give smoother results, but the deviation
+   * of a discarded Position is only measured against the neighbours it had when it was
+   * discarded.
+   */
+  enum class Simplification { DouglasPeucker, VisvalingamWhyatt };
+
+
+  /* Returns the (ascending) indices of the Positions retained when simplifying a route to
+   * within "tolerance" metres of horizontal cross-track error.  The first and last
+   * Positions are always retained.  Returning indices allows any data stored alongside
+   * the Positions (e.g. route point names) to be filtered in the same way.
+   */
+  std::vector<unsigned int> simplifiedIndices(const std::vector<Position> &,
+                                              metres tolerance,
+                                              Simplification = Simplification::DouglasPeucker);
+
+
+  // Returns the retained Positions, as selected by simplifiedIndices().
+  std::vector<Position> simplify(const std::vector<Position> &,
+                                 metres tolerance,
+                                 Simplification = Simplification::DouglasPeucker);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "earth.h"
+#include "distance.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( DistanceModels )
+
+const double percentageAccuracy = 0.0001;
+
+BOOST_AUTO_TEST_CASE( HaversineMatchesPositionDistanceBetween )
+{
+    BOOST_CHECK_EQUAL( Distance::Haversine::between(Earth::CliftonCampus, Earth::CityCampus) ,
+                       Position::distanceBetween(Earth::CliftonCampus, Earth::CityCampus) );
+}
+
+BOOST_AUTO_TEST_CASE( CoincidentPositions )
+{
+    BOOST_CHECK_EQUAL( Distance::Equirectangular::between(Earth::CityCampus, Earth::CityCampus) , 0 );
+    BOOST_CHECK_EQUAL( Distance::Haversine::between(Earth::CityCampus, Earth::CityCampus) , 0 );
+    BOOST_CHECK_EQUAL( Distance::Vincenty::between(Earth::CityCampus, Earth::CityCampus) , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( EquirectangularShortHop )
+{
+    const metres haversine = Distance::Haversine::between(Earth::CliftonCampus, Earth::CityCampus);
+    BOOST_CHECK_CLOSE( Distance::Equirectangular::between(Earth::CliftonCampus, Earth::CityCampus) , haversine , 0.1 );
+}
+
+BOOST_AUTO_TEST_CASE( EquirectangularAcrossAntiMeridian )
+{
+    const Position west = Position(10,-179.99);
+    const Position east = Position(10,179.99);
+    BOOST_CHECK_CLOSE( Distance::Equirectangular::between(west, east) , Distance::Haversine::between(west, east) , 0.1 );
+}
+
+// Flinders Peak to Buninyong, the standard test case from Vincenty's paper.
+BOOST_AUTO_TEST_CASE( VincentyReferenceGeodesic )
+{
+    const Position flindersPeak = Position(-(37 + 57/60.0 + 3.72030/3600), 144 + 25/60.0 + 29.52440/3600);
+    const Position buninyong = Position(-(37 + 39/60.0 + 10.15610/3600), 143 + 55/60.0 + 35.38390/3600);
+    BOOST_CHECK_CLOSE( Distance::Vincenty::between(flindersPeak, buninyong) , 54972.271 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( VincentyQuarterMeridian )
+{
+    BOOST_CHECK_CLOSE( Distance::Vincenty::between(Earth::EquatorialMeridian, Earth::NorthPole) , 10001965.729 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( DistanceAlgorithms )
+
+BOOST_AUTO_TEST_CASE( PathLength )
+{
+    const std::vector<Position> positions = { Earth::CliftonCampus, Earth::CityCampus, Earth::CliftonCampus };
+    const metres leg = Position::distanceBetween(Earth::CliftonCampus, Earth::CityCampus);
+    BOOST_CHECK_CLOSE( pathLength(positions) , 2 * leg , 0.0001 );
+    BOOST_CHECK_EQUAL( pathLength(std::vector<Position>()) , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( ThinToGranularity )
+{
+    const degrees step = Earth::latitudeSubtendedBy(10);
+    std::vector<Position> positions;
+    for (int i = 0; i < 10; ++i) positions.push_back(Position(i * step, 0));
+
+    BOOST_CHECK_EQUAL( thinToGranularity(positions, 5).size() , 10 );
+    BOOST_CHECK_EQUAL( thinToGranularity(positions, 15).size() , 5 );
+    BOOST_CHECK_EQUAL( thinToGranularity(positions, 1000).size() , 1 );
+    BOOST_CHECK( thinToGranularity(std::vector<Position>(), 15).empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,66 @@
+#include <cmath>
+
+#include "geometry.h"
+#include "earth.h"
+#include "distance.h"
+
+namespace GPS
+{
+  namespace Distance
+  {
+      metres Vincenty::between(const Position & p1, const Position & p2)
+      {
+          const double a = Earth::equatorialRadius;
+          const double f = Earth::flattening;
+          const double b = (1 - f) * a;
+
+          const radians L = degToRad(normaliseDeg(p2.longitude() - p1.longitude()));
+          const radians U1 = std::atan((1 - f) * std::tan(degToRad(p1.latitude())));
+          const radians U2 = std::atan((1 - f) * std::tan(degToRad(p2.latitude())));
+          const double sinU1 = std::sin(U1), cosU1 = std::cos(U1);
+          const double sinU2 = std::sin(U2), cosU2 = std::cos(U2);
+
+          const unsigned int maxIterations = 200;
+          const double convergenceLimit = 1e-12;
+
+          radians lambda = L;
+          double sinSigma, cosSigma, sigma, cosSqAlpha, cos2SigmaM;
+          unsigned int iterations = 0;
+          bool converged = false;
+
+          while (!converged && iterations++ < maxIterations)
+          {
+              const double sinLambda = std::sin(lambda);
+              const double cosLambda = std::cos(lambda);
+              const double x = cosU2 * sinLambda;
+              const double y = cosU1 * sinU2 - sinU1 * cosU2 * cosLambda;
+              sinSigma = std::sqrt(x*x + y*y);
+              if (sinSigma == 0) return 0; // Coincident points.
+
+              cosSigma = sinU1 * sinU2 + cosU1 * cosU2 * cosLambda;
+              sigma = std::atan2(sinSigma, cosSigma);
+              const double sinAlpha = cosU1 * cosU2 * sinLambda / sinSigma;
+              cosSqAlpha = 1 - sinAlpha * sinAlpha;
+              // On the equator cosSqAlpha is zero, and cos2SigmaM is irrelevant.
+              cos2SigmaM = (cosSqAlpha != 0) ? cosSigma - 2 * sinU1 * sinU2 / cosSqAlpha : 0;
+
+              const double C = f / 16 * cosSqAlpha * (4 + f * (4 - 3 * cosSqAlpha));
+              const radians previousLambda = lambda;
+              lambda = L + (1 - C) * f * sinAlpha
+                           * (sigma + C * sinSigma * (cos2SigmaM + C * cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)));
+              converged = std::abs(lambda - previousLambda) < convergenceLimit;
+          }
+
+          if (!converged) return Haversine::between(p1,p2);
+
+          const double uSq = cosSqAlpha * (a*a - b*b) / (b*b);
+          const double A = 1 + uSq / 16384 * (4096 + uSq * (-768 + uSq * (320 - 175 * uSq)));
+          const double B = uSq / 1024 * (256 + uSq * (-128 + uSq * (74 - 47 * uSq)));
+          const double deltaSigma = B * sinSigma
+                  * (cos2SigmaM + B / 4 * (cosSigma * (-1 + 2 * cos2SigmaM * cos2SigmaM)
+                     - B / 6 * cos2SigmaM * (-3 + 4 * sinSigma * sinSigma) * (-3 + 4 * cos2SigmaM * cos2SigmaM)));
+
+          return b * A * (sigma - deltaSigma);
+      }
+  }
+}
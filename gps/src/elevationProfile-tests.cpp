@@ -0,0 +1,133 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "routeSums.h"
+#include "elevationProfile.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ElevationProfiles )
+
+const double percentageAccuracy = 1.0;
+const metres epsilon = 0.0001;
+
+// Route points northwards along the meridian, "spacing" metres apart, with the given elevations.
+static std::vector<Position> meridianRoute(metres spacing, const std::vector<metres> & elevations)
+{
+    std::vector<Position> routePoints;
+    for (unsigned int i = 0; i < elevations.size(); ++i)
+    {
+        routePoints.push_back(Position(Earth::latitudeSubtendedBy(i * spacing), 0, elevations[i]));
+    }
+    return routePoints;
+}
+
+// 1km, climbing steadily by 100m.
+static std::vector<Position> ramp()
+{
+    return meridianRoute(100, { 0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100 });
+}
+
+// 2km of flat ground, with the elevation jittering by +/-1m every 10m.
+static std::vector<Position> noisyFlat()
+{
+    std::vector<metres> elevations;
+    for (unsigned int i = 0; i <= 200; ++i) elevations.push_back(i % 2 ? 51 : 49);
+    return meridianRoute(10, elevations);
+}
+
+BOOST_AUTO_TEST_CASE( Resampling )
+{
+    const ElevationProfile profile(ramp(), 30, ElevationSmoothing::None);
+    BOOST_CHECK_CLOSE( profile.length() , 1000 , percentageAccuracy );
+    BOOST_REQUIRE_EQUAL( profile.elevations().size() , 34 ); // 33 intervals of ~30.3m.
+    BOOST_CHECK_CLOSE( profile.step() , profile.length() / 33 , percentageAccuracy );
+    BOOST_CHECK_SMALL( profile.elevations().front() , epsilon );
+    BOOST_CHECK_CLOSE( profile.elevations()[1] , 100.0 / 33 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( profile.elevations().back() , 100 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( profile.elevationAt(profile.length() / 2) , 50 , percentageAccuracy );
+    BOOST_CHECK_SMALL( profile.elevationAt(-10) , epsilon );
+    BOOST_CHECK_CLOSE( profile.elevationAt(2000) , 100 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( GradientsOfRamp )
+{
+    const degrees expected = 5.7106; // atan(0.1)
+    for (ElevationSmoothing smoothing : { ElevationSmoothing::None, ElevationSmoothing::MovingAverage, ElevationSmoothing::SavitzkyGolay })
+    {
+        const ElevationProfile profile(ramp(), 25, smoothing, 7);
+        BOOST_CHECK_CLOSE( profile.maxGradient() , expected , percentageAccuracy );
+        BOOST_CHECK_CLOSE( profile.minGradient() , expected , percentageAccuracy );
+        BOOST_CHECK_CLOSE( profile.steepestGradient() , expected , percentageAccuracy );
+        BOOST_CHECK_CLOSE( profile.totalHeightGain() , 100 , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DownhillGradients )
+{
+    const ElevationProfile profile(meridianRoute(100, { 100, 90, 60, 60 }), 10, ElevationSmoothing::None);
+    BOOST_CHECK_SMALL( profile.maxGradient() , epsilon );
+    BOOST_CHECK_CLOSE( profile.minGradient() , -16.6992 , percentageAccuracy ); // atan(-0.3)
+    BOOST_CHECK_EQUAL( profile.steepestGradient() , profile.minGradient() );
+    BOOST_CHECK_SMALL( profile.totalHeightGain() , epsilon );
+}
+
+BOOST_AUTO_TEST_CASE( SmoothingSuppressesNoise )
+{
+    const std::vector<Position> routePoints = noisyFlat();
+    const metres rawGain = RouteSums(routePoints).totalHeightGain();
+    BOOST_CHECK_CLOSE( ElevationProfile(routePoints, 10, ElevationSmoothing::None).totalHeightGain() , rawGain , percentageAccuracy );
+
+    for (ElevationSmoothing smoothing : { ElevationSmoothing::MovingAverage, ElevationSmoothing::SavitzkyGolay, ElevationSmoothing::Kalman })
+    {
+        const ElevationProfile profile(routePoints, 10, smoothing, 5);
+        BOOST_CHECK_LT( profile.totalHeightGain() , rawGain / 2 );
+        BOOST_CHECK_LT( profile.steepestGradient() , 5.7106 );
+        BOOST_CHECK_CLOSE( profile.elevationAt(1000) , 50 , percentageAccuracy );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SinglePoint )
+{
+    const ElevationProfile profile({ Earth::CityCampus }, 10);
+    BOOST_CHECK_EQUAL( profile.elevations().size() , 1 );
+    BOOST_CHECK_SMALL( profile.length() , epsilon );
+    BOOST_CHECK_CLOSE( profile.elevationAt(5) , Earth::CityCampus.elevation() , percentageAccuracy );
+    BOOST_CHECK_SMALL( profile.totalHeightGain() , epsilon );
+    BOOST_CHECK_SMALL( profile.steepestGradient() , epsilon );
+}
+
+BOOST_AUTO_TEST_CASE( StationaryRoute )
+{
+    // The elevation jitters, but the horizontal position never changes.
+    const Position & p = Earth::CityCampus;
+    const std::vector<Position> routePoints = { Position(p.latitude(), p.longitude(), 10), Position(p.latitude(), p.longitude(), 12),
+                                                Position(p.latitude(), p.longitude(), 7), Position(p.latitude(), p.longitude(), 11) };
+    for (ElevationSmoothing smoothing : { ElevationSmoothing::None, ElevationSmoothing::SavitzkyGolay, ElevationSmoothing::Kalman })
+    {
+        const ElevationProfile profile(routePoints, 10, smoothing);
+        BOOST_REQUIRE_EQUAL( profile.elevations().size() , 1 );
+        BOOST_CHECK_CLOSE( profile.elevations().front() , 10 , percentageAccuracy );
+        BOOST_CHECK_SMALL( profile.length() , epsilon );
+        BOOST_CHECK_SMALL( profile.totalHeightGain() , epsilon );
+        BOOST_CHECK_SMALL( profile.maxGradient() , epsilon );
+        BOOST_CHECK_SMALL( profile.minGradient() , epsilon );
+        BOOST_CHECK_SMALL( profile.steepestGradient() , epsilon );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( InvalidProfiles )
+{
+    BOOST_CHECK_THROW( ElevationProfile(std::vector<Position>(), 10) , std::invalid_argument );
+    BOOST_CHECK_THROW( ElevationProfile(ramp(), 0) , std::invalid_argument );
+    BOOST_CHECK_THROW( ElevationProfile(ramp(), -5) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,208 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "routeSums.h"
+#include "elevationProfile.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // Samples at equal intervals along the route, of as close to "step" as possible.
+      std::vector<metres> resample(const std::vector<Position> & routePoints, metres step,
+                                   metres & length, metres & spacing)
+      {
+          const RouteSums sums(routePoints);
+          const std::vector<metres> & distances = sums.cumulativeLengths();
+          length = sums.totalLength();
+
+          if (length == 0) // E.g. a stationary receiver: there are no gradients, only a noisy elevation.
+          {
+              spacing = 0;
+              metres total = 0;
+              for (const Position & point : routePoints) total += point.elevation();
+              return { total / routePoints.size() };
+          }
+
+          const std::size_t numIntervals = std::max<std::size_t>(1, static_cast<std::size_t>(std::round(length / step)));
+          spacing = length / numIntervals;
+
+          std::vector<metres> samples;
+          samples.reserve(numIntervals + 1);
+
+          std::size_t segment = 0;
+          for (std::size_t i = 0; i < numIntervals; ++i)
+          {
+              const metres distance = i * spacing;
+              while (segment + 2 < distances.size() && distances[segment+1] <= distance) ++segment;
+
+              const metres segmentLength = distances[segment+1] - distances[segment];
+              const double t = (segmentLength == 0) ? 0 : std::min(1.0, (distance - distances[segment]) / segmentLength);
+              samples.push_back(routePoints[segment].elevation()
+                                + t * (routePoints[segment+1].elevation() - routePoints[segment].elevation()));
+          }
+          samples.push_back(routePoints.back().elevation());
+          return samples;
+      }
+
+      std::vector<metres> movingAverage(const std::vector<metres> & samples, std::size_t halfWidth)
+      {
+          // Prefix sums make each window's sum O(1), whatever its width.
+          std::vector<metres> sums(samples.size() + 1, 0);
+          for (std::size_t i = 0; i < samples.size(); ++i) sums[i+1] = sums[i] + samples[i];
+
+          std::vector<metres> smoothed(samples.size());
+          for (std::size_t i = 0; i < samples.size(); ++i)
+          {
+              const std::size_t h = std::min({ halfWidth, i, samples.size() - 1 - i });
+              smoothed[i] = (sums[i+h+1] - sums[i-h]) / (2*h + 1);
+          }
+          return smoothed;
+      }
+
+      std::vector<metres> savitzkyGolay(const std::vector<metres> & samples, std::size_t halfWidth)
+      {
+          /* Quadratic smoothing coefficients for a window of 2m+1 samples:
+           *   c(i) = (3(3m^2+3m-1) - 15i^2) / ((2m-1)(2m+1)(2m+3)),  for -m <= i <= m
+           */
+          std::vector<std::vector<double>> coefficients(halfWidth + 1);
+          for (std::size_t m = 2; m <= halfWidth; ++m)
+          {
+              const double mm = static_cast<double>(m);
+              const double norm = (2*mm - 1) * (2*mm + 1) * (2*mm + 3);
+              for (std::size_t i = 0; i <= m; ++i)
+              {
+                  coefficients[m].push_back((3 * (3*mm*mm + 3*mm - 1) - 15.0*i*i) / norm);
+              }
+          }
+
+          std::vector<metres> smoothed(samples.size());
+          for (std::size_t i = 0; i < samples.size(); ++i)
+          {
+              const std::size_t m = std::min({ halfWidth, i, samples.size() - 1 - i });
+              if (m < 2) // A quadratic fits 3 samples exactly, so average them instead.
+              {
+                  smoothed[i] = (m == 0) ? samples[i] : (samples[i-1] + samples[i] + samples[i+1]) / 3;
+                  continue;
+              }
+              const std::vector<double> & c = coefficients[m];
+              metres sum = c[0] * samples[i];
+              for (std::size_t j = 1; j <= m; ++j) sum += c[j] * (samples[i-j] + samples[i+j]);
+              smoothed[i] = sum;
+          }
+          return smoothed;
+      }
+
+      std::vector<metres> kalman(const std::vector<metres> & samples, std::size_t halfWidth)
+      {
+          const double gain = 2.0 / (2*halfWidth + 2); // As for an exponential moving average over the window.
+
+          std::vector<metres> forwards(samples.size());
+          metres estimate = samples.front();
+          for (std::size_t i = 0; i < samples.size(); ++i)
+          {
+              estimate += gain * (samples[i] - estimate);
+              forwards[i] = estimate;
+          }
+
+          std::vector<metres> smoothed(samples.size());
+          estimate = forwards.back();
+          for (std::size_t i = samples.size(); i-- > 0;)
+          {
+              estimate += gain * (forwards[i] - estimate);
+              smoothed[i] = estimate;
+          }
+          return smoothed;
+      }
+  }
+
+  ElevationProfile::ElevationProfile(const std::vector<Position> & routePoints,
+                                     metres step,
+                                     ElevationSmoothing smoothing,
+                                     unsigned int window)
+  {
+      if (routePoints.empty())
+          throw std::invalid_argument("An elevation profile requires at least one route point.");
+
+      if (!(step > 0))
+          throw std::invalid_argument("Elevation profile step must be positive.");
+
+      samples = resample(routePoints, step, totalLength, sampleStep);
+
+      const std::size_t halfWidth = window / 2;
+      switch (smoothing)
+      {
+          case ElevationSmoothing::None:          break;
+          case ElevationSmoothing::MovingAverage: samples = movingAverage(samples, halfWidth); break;
+          case ElevationSmoothing::SavitzkyGolay: samples = savitzkyGolay(samples, halfWidth); break;
+          case ElevationSmoothing::Kalman:        samples = kalman(samples, halfWidth); break;
+      }
+  }
+
+  metres ElevationProfile::step() const
+  {
+      return sampleStep;
+  }
+
+  metres ElevationProfile::length() const
+  {
+      return totalLength;
+  }
+
+  const std::vector<metres> & ElevationProfile::elevations() const
+  {
+      return samples;
+  }
+
+  metres ElevationProfile::elevationAt(metres distance) const
+  {
+      if (samples.size() == 1 || distance <= 0) return samples.front();
+      if (distance >= totalLength) return samples.back();
+
+      const std::size_t i = std::min(static_cast<std::size_t>(distance / sampleStep), samples.size() - 2);
+      const double t = (distance - i * sampleStep) / sampleStep;
+      return samples[i] + t * (samples[i+1] - samples[i]);
+  }
+
+  metres ElevationProfile::totalHeightGain() const
+  {
+      metres gain = 0;
+      for (std::size_t i = 1; i < samples.size(); ++i)
+      {
+          gain += std::max(samples[i] - samples[i-1], 0.0);
+      }
+      return gain;
+  }
+
+  degrees ElevationProfile::maxGradient() const
+  {
+      const std::vector<degrees> all = gradients();
+      return all.empty() ? 0 : *std::max_element(all.begin(), all.end());
+  }
+
+  degrees ElevationProfile::minGradient() const
+  {
+      const std::vector<degrees> all = gradients();
+      return all.empty() ? 0 : *std::min_element(all.begin(), all.end());
+  }
+
+  degrees ElevationProfile::steepestGradient() const
+  {
+      const degrees max = maxGradient();
+      const degrees min = minGradient();
+      return (std::abs(min) > std::abs(max)) ? min : max;
+  }
+
+  std::vector<degrees> ElevationProfile::gradients() const
+  {
+      std::vector<degrees> all;
+      all.reserve(samples.size());
+      for (std::size_t i = 1; i < samples.size(); ++i)
+      {
+          all.push_back(radToDeg(std::atan2(samples[i] - samples[i-1], sampleStep)));
+      }
+      return all;
+  }
+}
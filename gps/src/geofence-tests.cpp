@@ -0,0 +1,129 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "projection.h"
+#include "geofence.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Geofence )
+
+BOOST_AUTO_TEST_CASE( CircularFences )
+{
+    GeofenceIndex index;
+    const GeofenceIndex::FenceId clifton = index.addCircle(Earth::CliftonCampus, 500);
+    const GeofenceIndex::FenceId city = index.addCircle(Earth::CityCampus, 500);
+
+    BOOST_CHECK( index.fencesContaining(Earth::CliftonCampus) == std::vector<GeofenceIndex::FenceId>({clifton}) );
+    BOOST_CHECK( index.fencesContaining(offset(0, 450, Earth::CityCampus)) == std::vector<GeofenceIndex::FenceId>({city}) );
+    BOOST_CHECK( index.fencesContaining(offset(0, 550, Earth::CityCampus)).empty() );
+    BOOST_CHECK( index.fencesContaining(Earth::Pontianak).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( CircleEdges )
+{
+    // Just inside the circle, due East and West, where its bounding box is tightest.
+    for (const Position & centre : { Earth::EquatorialMeridian, Earth::CliftonCampus })
+    {
+        GeofenceIndex index;
+        const GeofenceIndex::FenceId fence = index.addCircle(centre, 100);
+        const LocalProjection projection(centre);
+        BOOST_CHECK( index.fencesContaining(projection.fromPlane({ 99.9, 0 })) == std::vector<GeofenceIndex::FenceId>({fence}) );
+        BOOST_CHECK( index.fencesContaining(projection.fromPlane({ -99.9, 0 })) == std::vector<GeofenceIndex::FenceId>({fence}) );
+        BOOST_CHECK( index.fencesContaining(projection.fromPlane({ 0, 99.9 })) == std::vector<GeofenceIndex::FenceId>({fence}) );
+        BOOST_CHECK( index.fencesContaining(projection.fromPlane({ 100.1, 0 })).empty() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( PolygonalFences )
+{
+    // An L-shaped polygon, 2km across.
+    const Position & origin = Earth::CliftonCampus;
+    GeofenceIndex index;
+    const GeofenceIndex::FenceId fence = index.addPolygon({ offset(0,0,origin), offset(0,2000,origin), offset(1000,2000,origin),
+                                                            offset(1000,1000,origin), offset(2000,1000,origin), offset(2000,0,origin) });
+
+    BOOST_CHECK( index.fencesContaining(offset(500,500,origin)) == std::vector<GeofenceIndex::FenceId>({fence}) );
+    BOOST_CHECK( index.fencesContaining(offset(1500,500,origin)) == std::vector<GeofenceIndex::FenceId>({fence}) );
+    BOOST_CHECK( index.fencesContaining(offset(1500,1500,origin)).empty() ); // In the notch of the L.
+    BOOST_CHECK( index.fencesContaining(offset(-10,500,origin)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( OverlappingFences )
+{
+    GeofenceIndex index(0.001);
+    std::vector<GeofenceIndex::FenceId> expected;
+    for (metres radius = 100; radius <= 5000; radius += 100)
+    {
+        expected.push_back(index.addCircle(Earth::CityCampus, radius));
+    }
+
+    BOOST_CHECK_EQUAL( index.numFences() , 50 );
+    BOOST_CHECK( index.fencesContaining(Earth::CityCampus) == expected );
+    BOOST_CHECK_EQUAL( index.fencesContaining(offset(2950, 0, Earth::CityCampus)).size() , 21 );
+}
+
+BOOST_AUTO_TEST_CASE( CountrySizedFences )
+{
+    // The polygon overlaps far too many cells to be registered in the grid.
+    GeofenceIndex index;
+    const GeofenceIndex::FenceId before = index.addCircle(Earth::CityCampus, 500);
+    const GeofenceIndex::FenceId country = index.addPolygon({ Position(50,-6), Position(50,2), Position(56,2), Position(56,-6) });
+    const GeofenceIndex::FenceId after = index.addCircle(Earth::CityCampus, 1000);
+
+    BOOST_CHECK( index.fencesContaining(Earth::CityCampus) == std::vector<GeofenceIndex::FenceId>({before, country, after}) );
+    BOOST_CHECK( index.fencesContaining(Earth::CliftonCampus) == std::vector<GeofenceIndex::FenceId>({country}) );
+    BOOST_CHECK( index.fencesContaining(Earth::Pontianak).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( PolarCircle )
+{
+    GeofenceIndex index;
+    index.addCircle(Earth::NorthPole, 1000);
+    BOOST_CHECK_EQUAL( index.fencesContaining(Position(89.995,-135)).size() , 1 );
+    BOOST_CHECK( index.fencesContaining(Position(89.98,45)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidFences )
+{
+    GeofenceIndex index;
+    BOOST_CHECK_THROW( index.addCircle(Earth::CityCampus, -1) , std::invalid_argument );
+    BOOST_CHECK_THROW( index.addCircle(Position(0,179.999), 1000) , std::invalid_argument );
+    BOOST_CHECK_THROW( index.addPolygon({ Earth::CityCampus, Earth::CliftonCampus }) , std::invalid_argument );
+    BOOST_CHECK_THROW( GeofenceIndex(0) , std::invalid_argument );
+    BOOST_CHECK_EQUAL( index.numFences() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( EnterAndExitEvents )
+{
+    GeofenceIndex index;
+    const GeofenceIndex::FenceId clifton = index.addCircle(Earth::CliftonCampus, 500);
+    const GeofenceIndex::FenceId city = index.addCircle(Earth::CityCampus, 500);
+
+    GeofenceTracker tracker(index);
+    const std::vector<GeofenceEvent> events =
+            tracker.update({ Earth::Pontianak, Earth::CliftonCampus, Earth::CliftonCampus, Earth::CityCampus, Earth::Pontianak });
+
+    BOOST_REQUIRE_EQUAL( events.size() , 4 );
+    BOOST_CHECK( events[0].positionIndex == 1 && events[0].fence == clifton && events[0].type == GeofenceEvent::Enter );
+    BOOST_CHECK( events[1].positionIndex == 3 && events[1].fence == clifton && events[1].type == GeofenceEvent::Exit );
+    BOOST_CHECK( events[2].positionIndex == 3 && events[2].fence == city && events[2].type == GeofenceEvent::Enter );
+    BOOST_CHECK( events[3].positionIndex == 4 && events[3].fence == city && events[3].type == GeofenceEvent::Exit );
+    BOOST_CHECK( tracker.currentFences().empty() );
+
+    // State carries over between batches.
+    BOOST_CHECK_EQUAL( tracker.update({ Earth::CityCampus }).size() , 1 );
+    BOOST_CHECK( tracker.update({ Earth::CityCampus }).empty() );
+    BOOST_CHECK( tracker.currentFences() == std::vector<GeofenceIndex::FenceId>({city}) );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+#include "geometry.h"
+#include "earth.h"
+#include "distance.h"
+#include "geofence.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const double unitsPerDegree = 1e7;
+
+      // Fences whose boxes overlap more grid cells than this are not registered in the grid.
+      const std::int64_t maxCellsPerFence = 1024;
+
+      /* The Earth helpers measure on the polar and equatorial circumferences, whereas the exact
+       * test in contains() uses the mean radius; scaling radii by the larger ratio of the two
+       * ensures that a circle's box never clips it.
+       */
+      const double boxPadding = std::max(Earth::equatorialCircumference, Earth::polarCircumference)
+                                / (2 * pi * Earth::meanRadius);
+
+      std::int32_t toUnits(degrees d)
+      {
+          return static_cast<std::int32_t>(std::floor(d * unitsPerDegree));
+      }
+
+      std::int32_t toUnitsRoundingUp(degrees d)
+      {
+          return static_cast<std::int32_t>(std::ceil(d * unitsPerDegree));
+      }
+
+      std::int64_t floorDiv(std::int64_t a, std::int64_t b)
+      {
+          return (a >= 0) ? a / b : -((-a + b - 1) / b);
+      }
+
+      std::uint64_t cellKey(std::int64_t row, std::int64_t col)
+      {
+          return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(row)) << 32) | static_cast<std::uint32_t>(col);
+      }
+  }
+
+  GeofenceIndex::GeofenceIndex(degrees cellSize)
+      : cellSize(toUnitsRoundingUp(cellSize))
+  {
+      if (this->cellSize <= 0)
+          throw std::invalid_argument("Geofence grid cells must have a positive size.");
+  }
+
+  GeofenceIndex::FenceId GeofenceIndex::addCircle(const Position & centre, metres radius)
+  {
+      if (radius < 0)
+          throw std::invalid_argument("Geofence radius must not be negative.");
+
+      const metres paddedRadius = radius * boxPadding;
+      const degrees deltaLat = Earth::latitudeSubtendedBy(paddedRadius);
+      const degrees minLat = std::max(centre.latitude() - deltaLat, -poleLatitude);
+      const degrees maxLat = std::min(centre.latitude() + deltaLat, poleLatitude);
+
+      // The box must be wide enough to contain the circle at its most polar latitude.
+      const degrees polarLat = std::max(std::abs(minLat), std::abs(maxLat));
+      const degrees deltaLon = (polarLat >= poleLatitude) ? fullRotation : Earth::longitudeSubtendedBy(paddedRadius, polarLat);
+      degrees minLon = centre.longitude() - deltaLon;
+      degrees maxLon = centre.longitude() + deltaLon;
+      if (deltaLon >= halfRotation)
+      {
+          // The circle contains a pole, so covers every longitude.
+          minLon = -antiMeridianLongitude;
+          maxLon = antiMeridianLongitude;
+      }
+
+      Fence fence;
+      fence.centreLat = centre.latitude();
+      fence.centreLon = centre.longitude();
+      fence.radius = radius;
+      fence.box = boxOf(minLat, maxLat, minLon, maxLon);
+      return add(fence);
+  }
+
+  GeofenceIndex::FenceId GeofenceIndex::addPolygon(const std::vector<Position> & vertices)
+  {
+      if (vertices.size() < 3)
+          throw std::invalid_argument("Polygonal geofences require at least three vertices.");
+
+      degrees minLat = vertices.front().latitude(), maxLat = minLat;
+      degrees minLon = vertices.front().longitude(), maxLon = minLon;
+      for (const Position & vertex : vertices)
+      {
+          minLat = std::min(minLat, vertex.latitude());
+          maxLat = std::max(maxLat, vertex.latitude());
+          minLon = std::min(minLon, vertex.longitude());
+          maxLon = std::max(maxLon, vertex.longitude());
+      }
+
+      Fence fence;
+      fence.vertices = vertices;
+      fence.centreLat = fence.centreLon = 0;
+      fence.radius = -1;
+      fence.box = boxOf(minLat, maxLat, minLon, maxLon);
+      return add(fence);
+  }
+
+  unsigned int GeofenceIndex::numFences() const
+  {
+      return static_cast<unsigned int>(fences.size());
+  }
+
+  std::vector<GeofenceIndex::FenceId> GeofenceIndex::fencesContaining(const Position & pos) const
+  {
+      std::vector<FenceId> found;
+
+      const std::int32_t lat = toUnits(pos.latitude());
+      const std::int32_t lon = toUnits(pos.longitude());
+      const auto cell = cells.find(cellKey(floorDiv(lat, cellSize), floorDiv(lon, cellSize)));
+      if (cell != cells.end()) addContaining(cell->second, pos, lat, lon, found);
+
+      const std::size_t numInCell = found.size();
+      addContaining(largeFences, pos, lat, lon, found);
+
+      // Fences are registered in ascending order of identifier, so each part is already sorted.
+      std::inplace_merge(found.begin(), found.begin() + numInCell, found.end());
+      return found;
+  }
+
+  void GeofenceIndex::addContaining(const std::vector<FenceId> & candidates, const Position & pos,
+                                    std::int32_t lat, std::int32_t lon, std::vector<FenceId> & found) const
+  {
+      for (FenceId id : candidates)
+      {
+          const Fence & fence = fences[id];
+          if (lat < fence.box.minLat || lat > fence.box.maxLat ||
+              lon < fence.box.minLon || lon > fence.box.maxLon) continue;
+
+          if (contains(fence, pos)) found.push_back(id);
+      }
+  }
+
+  GeofenceIndex::FenceId GeofenceIndex::add(Fence fence)
+  {
+      const FenceId id = static_cast<FenceId>(fences.size());
+      const std::int64_t firstRow = floorDiv(fence.box.minLat, cellSize), lastRow = floorDiv(fence.box.maxLat, cellSize);
+      const std::int64_t firstCol = floorDiv(fence.box.minLon, cellSize), lastCol = floorDiv(fence.box.maxLon, cellSize);
+      if ((lastRow - firstRow + 1) * (lastCol - firstCol + 1) > maxCellsPerFence)
+      {
+          largeFences.push_back(id);
+      }
+      else
+      {
+          for (std::int64_t row = firstRow; row <= lastRow; ++row)
+          {
+              for (std::int64_t col = firstCol; col <= lastCol; ++col)
+              {
+                  cells[cellKey(row, col)].push_back(id);
+              }
+          }
+      }
+      fences.push_back(std::move(fence));
+      return id;
+  }
+
+  GeofenceIndex::Box GeofenceIndex::boxOf(degrees minLat, degrees maxLat, degrees minLon, degrees maxLon)
+  {
+      if (minLon < -antiMeridianLongitude || maxLon > antiMeridianLongitude)
+          throw std::invalid_argument("Geofences must not span the anti-meridian.");
+
+      return { toUnits(minLat), toUnitsRoundingUp(maxLat), toUnits(minLon), toUnitsRoundingUp(maxLon) };
+  }
+
+  bool GeofenceIndex::contains(const Fence & fence, const Position & pos) const
+  {
+      if (fence.radius >= 0)
+      {
+          const Position centre = Position(fence.centreLat, fence.centreLon);
+          return Distance::Haversine::between(centre, pos) <= fence.radius;
+      }
+
+      // Even-odd rule: count the polygon edges crossed by a ray heading East from the Position.
+      const std::vector<Position> & vertices = fence.vertices;
+      bool inside = false;
+      for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+      {
+          const degrees latI = vertices[i].latitude(), lonI = vertices[i].longitude();
+          const degrees latJ = vertices[j].latitude(), lonJ = vertices[j].longitude();
+          if ((latI > pos.latitude()) != (latJ > pos.latitude()))
+          {
+              const degrees crossingLon = lonI + (pos.latitude() - latI) * (lonJ - lonI) / (latJ - latI);
+              if (pos.longitude() < crossingLon) inside = !inside;
+          }
+      }
+      return inside;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////
+
+  GeofenceTracker::GeofenceTracker(const GeofenceIndex & index)
+      : index(index) {}
+
+  std::vector<GeofenceEvent> GeofenceTracker::update(const std::vector<Position> & positions)
+  {
+      std::vector<GeofenceEvent> events;
+      for (unsigned int i = 0; i < positions.size(); ++i)
+      {
+          const std::vector<GeofenceIndex::FenceId> now = index.fencesContaining(positions[i]);
+          if (now == inside) continue; // The common case: no change.
+
+          std::vector<GeofenceIndex::FenceId> exited, entered;
+          std::set_difference(inside.begin(), inside.end(), now.begin(), now.end(), std::back_inserter(exited));
+          std::set_difference(now.begin(), now.end(), inside.begin(), inside.end(), std::back_inserter(entered));
+
+          for (GeofenceIndex::FenceId fence : exited) events.push_back({i, fence, GeofenceEvent::Exit});
+          for (GeofenceIndex::FenceId fence : entered) events.push_back({i, fence, GeofenceEvent::Enter});
+          inside = now;
+      }
+      return events;
+  }
+
+  const std::vector<GeofenceIndex::FenceId> & GeofenceTracker::currentFences() const
+  {
+      return inside;
+  }
+}
@@ -55,6 +55,19 @@ BOOST_AUTO_TEST_CASE( IncorrectChecksumsWithLowercaseHexDigits )
     BOOST_CHECK( ! isValidSentence("$GPRMC,115856.000,A,3722.6710,N,00559.3014,W,0.000,0.00,150914,,A*1d") );
 }
 
+BOOST_AUTO_TEST_CASE( OtherTalkerIDs )
+{
+    BOOST_CHECK( isValidSentence("$GNGLL,5425.31,N,107.03,W,82610*77") );
+    BOOST_CHECK( isValidSentence("$GLGGA,113922.000,3722.5993,N,00559.2458,W,1,0,,4.0,M,,M,,*5C") );
+    BOOST_CHECK( isValidSentence("$GARMC,113922.000,A,3722.5993,N,00559.2458,W,0.000,0.00,150914,,A*73") );
+    BOOST_CHECK( isValidSentence("$GBGLL,5425.31,N,107.03,W,82610*7B") );
+    BOOST_CHECK( isValidSentence("$GNVTG,054.7,T,034.4,M,005.5,N,010.2,K*56") );
+    BOOST_CHECK( isValidSentence("$GNGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1*27") );
+    BOOST_CHECK( isValidSentence("$GPGSV,2,1,08,01,40,083,46,02,17,308,41,12,07,344,39,14,22,228,45*75") );
+
+    BOOST_CHECK( ! isValidSentence("$BDGLL,5425.31,N,107.03,W,82610*78") ); // Unsupported talker ID.
+}
+
 BOOST_AUTO_TEST_CASE( IllFormedSentences )
 {
     BOOST_CHECK( ! isValidSentence("") );
@@ -130,6 +143,15 @@ BOOST_AUTO_TEST_CASE( RMC )
     BOOST_CHECK_EQUAL( decomposedSentence.second , std::vector<std::string>({"115856.000","A","3722.6710","N","00559.3014","W","0.000","0.00","150914","","A"}) );
 }
 
+BOOST_AUTO_TEST_CASE( GNGLL )
+{
+    NMEAPair decomposedSentence = decomposeSentence("$GNGLL,5425.31,N,107.03,W,82610*77");
+
+    BOOST_CHECK_EQUAL( decomposedSentence.first , std::string("GNGLL") );
+
+    BOOST_CHECK_EQUAL( decomposedSentence.second , std::vector<std::string>({"5425.31","N","107.03","W","82610"}) );
+}
+
 // Unsupported formats should decompose okay, but they will be rejected by extractPosition().
 BOOST_AUTO_TEST_CASE( UnsupportedFormat )
 {
@@ -144,6 +166,30 @@ BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
 
+BOOST_AUTO_TEST_SUITE( SentenceFormats )
+
+BOOST_AUTO_TEST_CASE( RecognisedFormats )
+{
+    BOOST_CHECK( sentenceFormat("GPGLL") == SentenceFormat::GLL );
+    BOOST_CHECK( sentenceFormat("GNGGA") == SentenceFormat::GGA );
+    BOOST_CHECK( sentenceFormat("GLRMC") == SentenceFormat::RMC );
+    BOOST_CHECK( sentenceFormat("GAVTG") == SentenceFormat::VTG );
+    BOOST_CHECK( sentenceFormat("GBGSA") == SentenceFormat::GSA );
+    BOOST_CHECK( sentenceFormat("GNGSV") == SentenceFormat::GSV );
+}
+
+BOOST_AUTO_TEST_CASE( UnrecognisedFormats )
+{
+    BOOST_CHECK( sentenceFormat("GPMSS") == SentenceFormat::Unsupported );
+    BOOST_CHECK( sentenceFormat("BDGLL") == SentenceFormat::Unsupported );
+    BOOST_CHECK( sentenceFormat("GPGL") == SentenceFormat::Unsupported );
+    BOOST_CHECK( sentenceFormat("") == SentenceFormat::Unsupported );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
 BOOST_AUTO_TEST_SUITE( ExtractPosition )
 
 const double epsilon = 0.0001;
@@ -266,10 +312,39 @@ BOOST_AUTO_TEST_CASE( GGA_NegativeElevation )
     BOOST_CHECK_CLOSE( pos.elevation() , -280.2 , percentageAccuracy );
 }
 
+BOOST_AUTO_TEST_CASE( OtherTalkerIDs )
+{
+    for (std::string talker : {"GN","GL","GA","GB"})
+    {
+        NMEAPair decomposedGLL = { talker + "GLL", {"5425.31","N","107.03","W","82610"} };
+        Position pos = extractPosition(decomposedGLL);
+        BOOST_CHECK_CLOSE( pos.latitude() , ddmTodd("5425.31") , percentageAccuracy );
+        BOOST_CHECK_CLOSE( pos.longitude() , -ddmTodd("107.03") , percentageAccuracy );
+
+        NMEAPair decomposedGGA = { talker + "GGA", {"170834","4124.8963","N","08151.6838","W","1","05","1.5","280.2","M","-34.0","M","",""} };
+        BOOST_CHECK_CLOSE( extractPosition(decomposedGGA).elevation() , 280.2 , percentageAccuracy );
+    }
+}
+
 BOOST_AUTO_TEST_CASE( UnsupportedFormat )
 {
     NMEAPair decomposedSentence = { "GPMSS", {"55","27","318.0","100",""} };
     BOOST_CHECK_THROW( extractPosition(decomposedSentence) , std::invalid_argument );
+
+    NMEAPair unsupportedTalker = { "BDGLL", {"5425.31","N","107.03","W","82610"} };
+    BOOST_CHECK_THROW( extractPosition(unsupportedTalker) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( FormatsWithoutPositions )
+{
+    NMEAPair vtg = { "GNVTG", {"054.7","T","034.4","M","005.5","N","010.2","K"} };
+    BOOST_CHECK_THROW( extractPosition(vtg) , std::invalid_argument );
+
+    NMEAPair gsa = { "GNGSA", {"A","3","04","05","","09","12","","","24","","","","","2.5","1.3","2.1"} };
+    BOOST_CHECK_THROW( extractPosition(gsa) , std::invalid_argument );
+
+    NMEAPair gsv = { "GPGSV", {"2","1","08","01","40","083","46","02","17","308","41","12","07","344","39","14","22","228","45"} };
+    BOOST_CHECK_THROW( extractPosition(gsv) , std::invalid_argument );
 }
 
 BOOST_AUTO_TEST_CASE( EmptyFieldVector )
@@ -338,6 +413,149 @@ BOOST_AUTO_TEST_CASE( InvalidFieldData )
     BOOST_CHECK_THROW( extractPosition(invalidGGA_M) , std::invalid_argument );
 }
 
+BOOST_AUTO_TEST_CASE( FixProvenance )
+{
+    NMEAPair gga = { "GPGGA", {"094627.000","3723.1622","N","00559.5788","W","1","0","","30.0","M","","M","",""} };
+    NMEAFix fix = extractFix(gga);
+    BOOST_CHECK( fix.hasElevation );
+    BOOST_CHECK_CLOSE( fix.position.elevation() , 30.0 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( fix.timeOfDay , 9*3600 + 46*60 + 27 , percentageAccuracy );
+
+    NMEAPair rmc = { "GPRMC", {"094627.000","A","3723.1622","N","00559.5788","W","0.000","0.00","150914","","A"} };
+    fix = extractFix(rmc);
+    BOOST_CHECK( ! fix.hasElevation );
+    BOOST_CHECK_CLOSE( fix.timeOfDay , 9*3600 + 46*60 + 27 , percentageAccuracy );
+
+    NMEAPair gll = { "GPGLL", {"5425.31","N","107.03","W","235959.5"} };
+    fix = extractFix(gll);
+    BOOST_CHECK( ! fix.hasElevation );
+    BOOST_CHECK_CLOSE( fix.timeOfDay , 86399.5 , percentageAccuracy );
+
+    NMEAPair untimed = { "GPGLL", {"5425.31","N","107.03","W"} };
+    BOOST_CHECK_EQUAL( extractFix(untimed).timeOfDay , -1 );
+
+    NMEAPair badTime = { "GPGLL", {"5425.31","N","107.03","W","noon"} };
+    BOOST_CHECK_EQUAL( extractFix(badTime).timeOfDay , -1 );
+
+    NMEAPair vtg = { "GNVTG", {"054.7","T","034.4","M","005.5","N","010.2","K"} };
+    BOOST_CHECK_THROW( extractFix(vtg) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( NonFiniteFieldData )
+{
+    // Such sentences can have valid checksums.
+    BOOST_REQUIRE( isValidSentence("$GPGLL,nan,N,0107.03,W,82610*12") );
+    BOOST_CHECK_THROW( extractPosition(decomposeSentence("$GPGLL,nan,N,0107.03,W,82610*12")) , std::invalid_argument );
+
+    NMEAPair infiniteRMC_W = { "GPRMC", {"115856.000","A","3722.6710","N","inf","W","0.000","0.00","150914","","A"} };
+    BOOST_CHECK_THROW( extractPosition(infiniteRMC_W) , std::invalid_argument );
+
+    NMEAPair infiniteGGA_M = { "GPGGA", {"170834","4124.8963","N","08151.6838","W","1","05","1.5","-INFINITY","M","-34.0","M","",""} };
+    BOOST_CHECK_THROW( extractPosition(infiniteGGA_M) , std::invalid_argument );
+
+    NMEAPair overflowingGGA_M = { "GPGGA", {"170834","4124.8963","N","08151.6838","W","1","05","1.5",std::string(400,'9'),"M","-34.0","M","",""} };
+    BOOST_CHECK_THROW( extractPosition(overflowingGGA_M) , std::invalid_argument );
+
+    NMEAPair underflowingGLL_N = { "GPGLL", {"0." + std::string(330,'0') + "1","N","107.03","W","82610"} };
+    BOOST_CHECK_THROW( extractPosition(underflowingGLL_N) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( NonDecimalFieldData )
+{
+    NMEAPair hexGLL_N = { "GPGLL", {"0x1p4","N","107.03","W","82610"} };
+    BOOST_CHECK_THROW( extractPosition(hexGLL_N) , std::invalid_argument );
+
+    NMEAPair exponentGLL_E = { "GPGLL", {"5425.31","N","1.0703e2","W","82610"} };
+    BOOST_CHECK_THROW( extractPosition(exponentGLL_E) , std::invalid_argument );
+
+    NMEAPair signOnlyGGA_M = { "GPGGA", {"170834","4124.8963","N","08151.6838","W","1","05","1.5","-","M","-34.0","M","",""} };
+    BOOST_CHECK_THROW( extractPosition(signOnlyGGA_M) , std::invalid_argument );
+
+    NMEAPair twoPointsGLL_N = { "GPGLL", {"54.25.31","N","107.03","W","82610"} };
+    BOOST_CHECK_THROW( extractPosition(twoPointsGLL_N) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ExtractOtherFields )
+
+const double percentageAccuracy = 0.0001;
+
+BOOST_AUTO_TEST_CASE( CourseFromVTG )
+{
+    NMEAPair vtg = { "GNVTG", {"054.7","T","034.4","M","005.5","N","010.2","K"} };
+    CourseOverGround course = extractCourse(vtg);
+    BOOST_CHECK_CLOSE( course.course , 54.7 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( course.knots , 5.5 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( CourseFromRMC )
+{
+    NMEAPair rmc = { "GPRMC", {"123519","A","4807.038","N","01131.000","E","022.4","084.4","230394","003.1","W"} };
+    CourseOverGround course = extractCourse(rmc);
+    BOOST_CHECK_CLOSE( course.course , 84.4 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( course.knots , 22.4 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( DilutionFromGSA )
+{
+    NMEAPair gsa = { "GNGSA", {"A","3","04","05","","09","12","","","24","","","","","2.5","1.3","2.1"} };
+    DilutionOfPrecision dop = extractDilution(gsa);
+    BOOST_CHECK_EQUAL( dop.fixType , 3 );
+    BOOST_CHECK_CLOSE( dop.position , 2.5 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dop.horizontal , 1.3 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( dop.vertical , 2.1 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( SatellitesFromGSV )
+{
+    NMEAPair first = { "GPGSV", {"2","1","08","01","40","083","46","02","17","308","41","12","07","344","39","14","22","228","45"} };
+    SatellitesInView inView = extractSatellites(first);
+    BOOST_CHECK_EQUAL( inView.numSatellites , 8 );
+    BOOST_REQUIRE_EQUAL( inView.satellites.size() , 4 );
+    BOOST_CHECK_EQUAL( inView.satellites[0].id , 1 );
+    BOOST_CHECK_CLOSE( inView.satellites[0].elevation , 40 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( inView.satellites[0].azimuth , 83 , percentageAccuracy );
+    BOOST_CHECK_EQUAL( inView.satellites[0].signalToNoise , 46 );
+    BOOST_CHECK_EQUAL( inView.satellites[3].id , 14 );
+
+    // The final sentence of a sequence describes the remaining satellites; untracked satellites have no SNR.
+    NMEAPair last = { "GLGSV", {"2","2","08","15","30","050","","17","10","120","33","","","","","","","",""} };
+    inView = extractSatellites(last);
+    BOOST_REQUIRE_EQUAL( inView.satellites.size() , 2 );
+    BOOST_CHECK_EQUAL( inView.satellites[0].id , 15 );
+    BOOST_CHECK_EQUAL( inView.satellites[0].signalToNoise , -1 );
+    BOOST_CHECK_EQUAL( inView.satellites[1].signalToNoise , 33 );
+}
+
+BOOST_AUTO_TEST_CASE( FormatsWithoutTheFields )
+{
+    NMEAPair gll = { "GPGLL", {"5425.31","N","107.03","W","82610"} };
+    BOOST_CHECK_THROW( extractCourse(gll) , std::invalid_argument );
+    BOOST_CHECK_THROW( extractDilution(gll) , std::invalid_argument );
+    BOOST_CHECK_THROW( extractSatellites(gll) , std::invalid_argument );
+
+    NMEAPair unsupported = { "GPMSS", {"55","27","318.0","100",""} };
+    BOOST_CHECK_THROW( extractCourse(unsupported) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidOtherFieldData )
+{
+    NMEAPair vtg = { "GNVTG", {"","T","","M","005.5","N","010.2","K"} };
+    BOOST_CHECK_THROW( extractCourse(vtg) , std::invalid_argument );
+
+    NMEAPair gsa = { "GNGSA", {"A","3D","04","05","","09","12","","","24","","","","","2.5","1.3","2.1"} };
+    BOOST_CHECK_THROW( extractDilution(gsa) , std::invalid_argument );
+
+    NMEAPair truncatedGSA = { "GNGSA", {"A","3","04"} };
+    BOOST_CHECK_THROW( extractDilution(truncatedGSA) , std::invalid_argument );
+
+    NMEAPair gsv = { "GPGSV", {"2","1","08","01","high","083","46"} };
+    BOOST_CHECK_THROW( extractSatellites(gsv) , std::invalid_argument );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 /////////////////////////////////////////////////////////////////////////////////////////
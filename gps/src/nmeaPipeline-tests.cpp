@@ -0,0 +1,178 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "ringBuffer.h"
+#include "nmeaPipeline.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+/* While non-zero, allocations of at least this many bytes fail, so that the tests can make a
+ * pipeline stage throw.  This replaces operator new for the whole test executable, but it
+ * behaves like the default one while the limit is zero.
+ */
+static std::atomic<std::size_t> failAllocationsFrom {0};
+
+void * operator new(std::size_t size)
+{
+    const std::size_t limit = failAllocationsFrom;
+    if (limit != 0 && size >= limit) throw std::bad_alloc();
+    if (void * memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (const std::bad_alloc &)
+    {
+        return nullptr;
+    }
+}
+
+// Not inlined, so that the compiler does not mistake these for a free() of memory from the built-in new.
+[[gnu::noinline]] void operator delete(void * memory) noexcept
+{
+    std::free(memory);
+}
+
+// Libraries compiled for C++14 or later call the sized form.
+[[gnu::noinline]] void operator delete(void * memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+[[gnu::noinline]] void operator delete(void * memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+// Fails large allocations during its lifetime.
+struct AllocationLimit
+{
+    explicit AllocationLimit(std::size_t bytes) { failAllocationsFrom = bytes; }
+    ~AllocationLimit() { failAllocationsFrom = 0; }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RingBuffer )
+
+BOOST_AUTO_TEST_CASE( BoundedCapacity )
+{
+    SPSCRingBuffer<int,4> buffer;
+    int item;
+    BOOST_CHECK( ! buffer.tryPop(item) );
+
+    for (int i = 0; i < 4; ++i)
+    {
+        item = i;
+        BOOST_CHECK( buffer.tryPush(item) );
+    }
+    item = 4;
+    BOOST_CHECK( ! buffer.tryPush(item) );
+
+    BOOST_CHECK( buffer.tryPop(item) );
+    BOOST_CHECK_EQUAL( item , 0 );
+    item = 4;
+    BOOST_CHECK( buffer.tryPush(item) );
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        BOOST_CHECK( buffer.tryPop(item) );
+        BOOST_CHECK_EQUAL( item , i );
+    }
+    BOOST_CHECK( ! buffer.tryPop(item) );
+}
+
+BOOST_AUTO_TEST_CASE( PreservesOrderAcrossThreads )
+{
+    const int numItems = 100000;
+    SPSCRingBuffer<int,8> buffer;
+    std::thread producer([&]() { for (int i = 0; i < numItems; ++i) buffer.push(i); });
+
+    int outOfOrder = 0;
+    for (int i = 0; i < numItems; ++i)
+    {
+        if (buffer.pop() != i) ++outOfOrder;
+    }
+    producer.join();
+
+    BOOST_CHECK_EQUAL( outOfOrder , 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteFromNMEALogPipelined )
+
+void checkMatchesSequential(const std::string & filepath, const std::vector<int> & stageCores = {})
+{
+    BOOST_CHECK( bitIdentical(routeFromNMEALogPipelined(filepath, stageCores), routeFromNMEALog(filepath)) );
+}
+
+BOOST_AUTO_TEST_CASE( Log_GLL )
+{
+    checkMatchesSequential(LogFiles::NMEALogsDir + "gll.log");
+}
+
+BOOST_AUTO_TEST_CASE( Log_GGA_RMC )
+{
+    checkMatchesSequential(LogFiles::NMEALogsDir + "gga_rmc.log");
+}
+
+BOOST_AUTO_TEST_CASE( AnnotatedLog_GGA_RMC )
+{
+    checkMatchesSequential(LogFiles::NMEALogsDir + "gga_rmc-annotated.log", {0,0,0,0,0});
+}
+
+BOOST_AUTO_TEST_CASE( MissingFile )
+{
+    BOOST_CHECK( routeFromNMEALogPipelined(LogFiles::NMEALogsDir + "no-such-file.log").empty() );
+}
+
+BOOST_AUTO_TEST_CASE( UnderflowingFieldIsIgnored )
+{
+    // The checksum is valid, but the latitude underflows a double.
+    const TempFile log(fileContents(LogFiles::NMEALogsDir + "gll.log")
+                       + "$GPGLL,0." + std::string(330,'0') + "1,N,0107.03,W,82610*5C\n");
+    checkMatchesSequential(log.path);
+}
+
+BOOST_AUTO_TEST_CASE( StageFailuresAreRethrown )
+{
+    std::string contents;
+    for (int i = 0; i < 20; ++i) contents += fileContents(LogFiles::NMEALogsDir + "gll.log");
+    const TempFile log(contents);
+
+    {
+        // Fails in the read stage, when it allocates its first block.
+        const AllocationLimit limit(64 * 1024);
+        BOOST_CHECK_THROW( routeFromNMEALogPipelined(log.path) , std::bad_alloc );
+    }
+    {
+        // Fails in the accumulate stage, once the route outgrows the limit.
+        const AllocationLimit limit(128 * 1024);
+        BOOST_CHECK_THROW( routeFromNMEALogPipelined(log.path) , std::bad_alloc );
+    }
+    checkMatchesSequential(log.path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,309 @@
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "parseNMEA.h"
+#include "ringBuffer.h"
+#include "nmeaPipeline.h"
+
+namespace GPS
+{
+  namespace
+  {
+      const std::size_t blockSize = 64 * 1024; // Bytes read from the file at a time.
+      const std::size_t batchSize = 64;        // Sentences passed between stages at a time.
+      const std::size_t queueCapacity = 16;    // Batches buffered between stages.
+
+      // A sentence within a block of the file; eight of these fit in a cache line.
+      struct SentenceDescriptor
+      {
+          std::uint32_t offset;
+          std::uint32_t length;
+      };
+
+      /* Every stage passes batches of its output downstream.  A batch flagged as the end of
+       * the stream is the last one that a stage receives.
+       */
+      template <typename Item>
+      struct Batch
+      {
+          std::vector<Item> items;
+          bool endOfStream = false;
+      };
+
+      struct SentenceBatch : Batch<SentenceDescriptor>
+      {
+          std::shared_ptr<const std::string> block; // Shared by all batches from the same block.
+      };
+
+      using DecodedBatch = Batch<NMEAPair>;
+      using PositionBatch = Batch<Position>;
+
+      template <typename T>
+      using Queue = SPSCRingBuffer<T, queueCapacity>;
+
+      /* The first exception thrown by any stage.  A stage that throws records its exception,
+       * and the pipeline rethrows it once every stage has finished.
+       */
+      class StageErrors
+      {
+        public:
+          void record(std::exception_ptr error)
+          {
+              std::lock_guard<std::mutex> lock(mutex);
+              if (!firstError) firstError = error;
+              failed = true;
+          }
+
+          bool anyFailed() const { return failed; }
+
+          // Only once all the stages have been joined.
+          void rethrowFirst() const
+          {
+              if (firstError) std::rethrow_exception(firstError);
+          }
+
+        private:
+          std::mutex mutex;
+          std::exception_ptr firstError;
+          std::atomic<bool> failed {false};
+      };
+
+      /* After a stage has thrown, it must still let its neighbours finish: it discards the rest
+       * of its input, so that the upstream stage is never blocked on a full queue, and passes
+       * the end of the stream downstream.
+       */
+      template <typename InputBatch>
+      void discardUntilEnd(Queue<InputBatch> & input, bool endOfStream)
+      {
+          while (!endOfStream) endOfStream = input.pop().endOfStream;
+      }
+
+      template <typename OutputBatch>
+      void pushEnd(Queue<OutputBatch> & output)
+      {
+          OutputBatch end;
+          end.endOfStream = true;
+          output.push(std::move(end));
+      }
+
+      void pinToCore(std::thread & thread, int core)
+      {
+#ifdef __linux__
+          if (core < 0) return;
+          cpu_set_t cpus;
+          CPU_ZERO(&cpus);
+          CPU_SET(core, &cpus);
+          pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+#else
+          (void) thread;
+          (void) core;
+#endif
+      }
+
+      void readStage(const std::string & filepath, Queue<SentenceBatch> & output, StageErrors & errors)
+      {
+          try
+          {
+              std::ifstream file(filepath, std::ios::binary);
+              std::string carried; // An incomplete line at the end of the previous block.
+
+              while (file && !errors.anyFailed()) // No point reading on once a later stage has failed.
+              {
+                  std::shared_ptr<std::string> block = std::make_shared<std::string>(std::move(carried));
+                  const std::size_t carriedSize = block->size();
+                  block->resize(carriedSize + blockSize);
+                  file.read(&(*block)[carriedSize], blockSize);
+                  block->resize(carriedSize + static_cast<std::size_t>(file.gcount()));
+                  const bool endOfFile = !file;
+
+                  SentenceBatch batch;
+                  batch.block = block;
+                  std::size_t lineStart = 0;
+                  while (lineStart < block->size())
+                  {
+                      std::size_t lineEnd = block->find('\n', lineStart);
+                      if (lineEnd == std::string::npos)
+                      {
+                          if (!endOfFile) break; // Carry the incomplete line into the next block.
+                          lineEnd = block->size();
+                      }
+
+                      std::size_t length = lineEnd - lineStart;
+                      if (length > 0 && (*block)[lineStart + length - 1] == '\r') --length;
+                      if (length > 0)
+                      {
+                          batch.items.push_back({static_cast<std::uint32_t>(lineStart), static_cast<std::uint32_t>(length)});
+                          if (batch.items.size() == batchSize)
+                          {
+                              output.push(std::move(batch));
+                              batch = SentenceBatch();
+                              batch.block = block;
+                          }
+                      }
+                      lineStart = lineEnd + 1;
+                  }
+                  if (!batch.items.empty()) output.push(std::move(batch));
+
+                  carried = (lineStart < block->size()) ? block->substr(lineStart) : std::string();
+              }
+          }
+          catch (...)
+          {
+              errors.record(std::current_exception());
+          }
+          pushEnd(output);
+      }
+
+      void validateStage(Queue<SentenceBatch> & input, Queue<SentenceBatch> & output, StageErrors & errors)
+      {
+          bool endOfStream = false;
+          try
+          {
+              while (!endOfStream)
+              {
+                  SentenceBatch batch = input.pop();
+                  endOfStream = batch.endOfStream;
+
+                  std::vector<SentenceDescriptor> & sentences = batch.items;
+                  std::size_t numValid = 0;
+                  for (const SentenceDescriptor & sentence : sentences)
+                  {
+                      if (isValidSentence(batch.block->substr(sentence.offset, sentence.length)))
+                      {
+                          sentences[numValid++] = sentence;
+                      }
+                  }
+                  sentences.resize(numValid);
+
+                  if (!sentences.empty() || endOfStream) output.push(std::move(batch));
+              }
+          }
+          catch (...)
+          {
+              errors.record(std::current_exception());
+              discardUntilEnd(input, endOfStream);
+              pushEnd(output);
+          }
+      }
+
+      void decodeStage(Queue<SentenceBatch> & input, Queue<DecodedBatch> & output, StageErrors & errors)
+      {
+          bool endOfStream = false;
+          try
+          {
+              while (!endOfStream)
+              {
+                  const SentenceBatch batch = input.pop();
+                  endOfStream = batch.endOfStream;
+
+                  DecodedBatch decoded;
+                  decoded.endOfStream = endOfStream;
+                  decoded.items.reserve(batch.items.size());
+                  for (const SentenceDescriptor & sentence : batch.items)
+                  {
+                      decoded.items.push_back(decomposeSentence(batch.block->substr(sentence.offset, sentence.length)));
+                  }
+                  output.push(std::move(decoded));
+              }
+          }
+          catch (...)
+          {
+              errors.record(std::current_exception());
+              discardUntilEnd(input, endOfStream);
+              pushEnd(output);
+          }
+      }
+
+      void extractStage(Queue<DecodedBatch> & input, Queue<PositionBatch> & output, StageErrors & errors)
+      {
+          bool endOfStream = false;
+          try
+          {
+              while (!endOfStream)
+              {
+                  const DecodedBatch batch = input.pop();
+                  endOfStream = batch.endOfStream;
+
+                  PositionBatch positions;
+                  positions.endOfStream = endOfStream;
+                  positions.items.reserve(batch.items.size());
+                  for (const NMEAPair & pair : batch.items)
+                  {
+                      try
+                      {
+                          positions.items.push_back(extractPosition(pair));
+                      }
+                      catch (const std::logic_error &)
+                      {
+                          // Unsupported or ill-formed sentences are ignored, as in routeFromNMEALog().
+                      }
+                  }
+                  if (!positions.items.empty() || endOfStream) output.push(std::move(positions));
+              }
+          }
+          catch (...)
+          {
+              errors.record(std::current_exception());
+              discardUntilEnd(input, endOfStream);
+              pushEnd(output);
+          }
+      }
+
+      void accumulateStage(Queue<PositionBatch> & input, std::vector<Position> & route, StageErrors & errors)
+      {
+          bool endOfStream = false;
+          try
+          {
+              while (!endOfStream)
+              {
+                  const PositionBatch batch = input.pop();
+                  endOfStream = batch.endOfStream;
+                  route.insert(route.end(), batch.items.begin(), batch.items.end());
+              }
+          }
+          catch (...)
+          {
+              errors.record(std::current_exception());
+              discardUntilEnd(input, endOfStream);
+          }
+      }
+  }
+
+  std::vector<Position> routeFromNMEALogPipelined(const std::string & filepath,
+                                                  const std::vector<int> & stageCores)
+  {
+      Queue<SentenceBatch> read, validated;
+      Queue<DecodedBatch> decoded;
+      Queue<PositionBatch> extracted;
+      std::vector<Position> route;
+      StageErrors errors;
+
+      std::vector<std::thread> stages;
+      stages.emplace_back(readStage, std::cref(filepath), std::ref(read), std::ref(errors));
+      stages.emplace_back(validateStage, std::ref(read), std::ref(validated), std::ref(errors));
+      stages.emplace_back(decodeStage, std::ref(validated), std::ref(decoded), std::ref(errors));
+      stages.emplace_back(extractStage, std::ref(decoded), std::ref(extracted), std::ref(errors));
+      stages.emplace_back(accumulateStage, std::ref(extracted), std::ref(route), std::ref(errors));
+
+      for (std::size_t i = 0; i < stages.size() && i < stageCores.size(); ++i)
+      {
+          pinToCore(stages[i], stageCores[i]);
+      }
+
+      for (std::thread & stage : stages) stage.join();
+      errors.rethrowFirst();
+      return route;
+  }
+}
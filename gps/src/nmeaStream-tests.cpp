@@ -0,0 +1,171 @@
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <thread>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "logs.h"
+#include "parseNMEA.h"
+#include "nmeaStream.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( NMEAStream )
+
+// Writes the data to the file descriptor in small chunks, to split sentences across reads.
+// Called from writer threads, so failures are left to show up as missing Positions.
+void replay(int fileDescriptor, const std::string & data, std::size_t chunkSize = 7)
+{
+    for (std::size_t i = 0; i < data.size(); i += chunkSize)
+    {
+        const std::string chunk = data.substr(i, chunkSize);
+        if (::write(fileDescriptor, chunk.data(), chunk.size()) != ssize_t(chunk.size())) return;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( SentencesSplitAcrossChunks )
+{
+    std::vector<Position> route;
+    NMEAStreamReader reader([&](const Position & pos) { route.push_back(pos); });
+
+    const std::string data = "$GPGLL,5425.31,N,107.03,W,82610*69\r\n\n$GPMSS,55,27,318.0,100,*66\n$GPGGA,113922.000,3722.5993,N,00559.2458,W,1,0,,4.0,M,,M,,*40";
+    for (char c : data) reader.consume(&c, 1);
+    BOOST_CHECK_EQUAL( route.size() , 1 );
+
+    reader.finish(); // The final sentence is unterminated.
+    BOOST_REQUIRE_EQUAL( route.size() , 2 );
+    BOOST_CHECK_CLOSE( route[1].elevation() , 4.0 , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( OverlongLinesAreDiscarded )
+{
+    std::vector<Position> route;
+    NMEAStreamReader reader([&](const Position & pos) { route.push_back(pos); });
+
+    // The overlong line arrives over several reads, so it must be abandoned before its end is seen.
+    const std::string garbage(NMEAStreamReader::maxLineLength / 2, 'x');
+    for (int i = 0; i < 6; ++i) reader.consume(garbage.data(), garbage.size());
+
+    // Were the reader to resume buffering, this tail of the overlong line would look like a valid sentence.
+    const std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69";
+    reader.consume(sentence.data(), sentence.size());
+    reader.consume("\n", 1);
+    BOOST_CHECK_EQUAL( route.size() , 0 );
+
+    // The next line is read normally.
+    const std::string next = sentence + "\n";
+    reader.consume(next.data(), next.size());
+    BOOST_CHECK_EQUAL( route.size() , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( UnderflowingFieldIsIgnored )
+{
+    std::vector<Position> route;
+    NMEAStreamReader reader([&](const Position & pos) { route.push_back(pos); });
+
+    // The checksum is valid, but the latitude underflows a double.
+    const std::string data = "$GPGLL,0." + std::string(330,'0') + "1,N,0107.03,W,82610*5C\n$GPGLL,5425.31,N,107.03,W,82610*69\n";
+    BOOST_CHECK_NO_THROW( reader.consume(data.data(), data.size()) );
+    BOOST_CHECK_EQUAL( route.size() , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( ReplayLogThroughPipe )
+{
+    const std::string logFile = LogFiles::NMEALogsDir + "gga_rmc-annotated.log";
+
+    int pipeEnds[2];
+    BOOST_REQUIRE_EQUAL( ::pipe(pipeEnds) , 0 );
+    std::thread writer([&]() { replay(pipeEnds[1], fileContents(logFile)); ::close(pipeEnds[1]); });
+
+    std::vector<Position> route;
+    NMEAStreamReader reader([&](const Position & pos) { route.push_back(pos); });
+    while (reader.readFrom(pipeEnds[0])) {}
+    writer.join();
+    ::close(pipeEnds[0]);
+
+    BOOST_CHECK( bitIdentical(route, routeFromNMEALog(logFile)) );
+}
+
+BOOST_AUTO_TEST_CASE( HandlerExceptionsPropagate )
+{
+    NMEAStreamReader reader([](const Position &) { throw std::invalid_argument("Rejected by handler"); });
+
+    const std::string sentence = "$GPGLL,5425.31,N,107.03,W,82610*69\n";
+    BOOST_CHECK_THROW( reader.consume(sentence.data(), sentence.size()) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( ReplayLogThroughPseudoTerminal )
+{
+    const std::string logFile = LogFiles::NMEALogsDir + "gll.log";
+
+    const int master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    BOOST_REQUIRE( master >= 0 );
+    BOOST_REQUIRE_EQUAL( ::grantpt(master) , 0 );
+    BOOST_REQUIRE_EQUAL( ::unlockpt(master) , 0 );
+    const int slave = ::open(::ptsname(master), O_RDWR | O_NOCTTY);
+    BOOST_REQUIRE( slave >= 0 );
+
+    // Like a GPS serial port: no echo or line-ending translation.
+    termios settings;
+    ::tcgetattr(slave, &settings);
+    ::cfmakeraw(&settings);
+    ::tcsetattr(slave, TCSANOW, &settings);
+
+    std::thread writer([&]() { replay(slave, fileContents(logFile)); ::close(slave); });
+
+    std::vector<Position> route;
+    NMEAStreamReader reader([&](const Position & pos) { route.push_back(pos); });
+    while (reader.readFrom(master)) {}
+    writer.join();
+    ::close(master);
+
+    BOOST_CHECK( bitIdentical(route, routeFromNMEALog(logFile)) );
+}
+
+BOOST_AUTO_TEST_CASE( PollerMultiplexesStreams )
+{
+    const std::vector<std::string> logFiles = { "gll.log", "gga_rmc.log", "gga_rmc-annotated.log" };
+
+    NMEAStreamPoller poller;
+    std::vector<std::vector<Position>> routes(logFiles.size());
+    std::vector<std::thread> writers;
+    std::vector<int> readEnds;
+
+    for (std::size_t i = 0; i < logFiles.size(); ++i)
+    {
+        int pipeEnds[2];
+        BOOST_REQUIRE_EQUAL( ::pipe2(pipeEnds, O_NONBLOCK) , 0 );
+        ::fcntl(pipeEnds[1], F_SETFL, 0); // Only the reading end should be non-blocking.
+        readEnds.push_back(pipeEnds[0]);
+
+        std::vector<Position> & route = routes[i];
+        poller.add(pipeEnds[0], [&route](const Position & pos) { route.push_back(pos); });
+
+        const std::string data = fileContents(LogFiles::NMEALogsDir + logFiles[i]);
+        const int writeEnd = pipeEnds[1];
+        writers.emplace_back([data,writeEnd]() { replay(writeEnd, data, 100); ::close(writeEnd); });
+    }
+
+    while (poller.numStreams() > 0) poller.poll(-1);
+    for (std::thread & writer : writers) writer.join();
+    for (int readEnd : readEnds) ::close(readEnd);
+
+    for (std::size_t i = 0; i < logFiles.size(); ++i)
+    {
+        BOOST_CHECK( bitIdentical(routes[i], routeFromNMEALog(LogFiles::NMEALogsDir + logFiles[i])) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/epoll.h>
+
+#include "parseNMEA.h"
+#include "nmeaStream.h"
+
+namespace GPS
+{
+  NMEAStreamReader::NMEAStreamReader(PositionHandler handler)
+      : handler([handler](const NMEAFix & fix) { handler(fix.position); }) {}
+
+  NMEAStreamReader::NMEAStreamReader(FixHandler handler)
+      : handler(handler) {}
+
+  void NMEAStreamReader::consume(const char * data, std::size_t length)
+  {
+      const char * const end = data + length;
+      while (data != end)
+      {
+          const char * newline = std::find(data, end, '\n');
+          if (newline == end)
+          {
+              // Keep the unterminated remainder until more data arrives.
+              if (!discarding) partialLine.append(data, end);
+              if (partialLine.size() > maxLineLength)
+              {
+                  partialLine.clear();
+                  discarding = true;
+              }
+              return;
+          }
+
+          if (discarding)
+          {
+              discarding = false;
+          }
+          else if (partialLine.empty())
+          {
+              processLine(data, newline); // Common case: no copying required.
+          }
+          else
+          {
+              partialLine.append(data, newline);
+              processLine(partialLine.data(), partialLine.data() + partialLine.size());
+              partialLine.clear();
+          }
+          data = newline + 1;
+      }
+  }
+
+  void NMEAStreamReader::finish()
+  {
+      if (!discarding && !partialLine.empty())
+      {
+          processLine(partialLine.data(), partialLine.data() + partialLine.size());
+      }
+      partialLine.clear();
+      discarding = false;
+  }
+
+  bool NMEAStreamReader::readFrom(int fileDescriptor)
+  {
+      char buffer[4096];
+      while (true)
+      {
+          const ssize_t bytesRead = ::read(fileDescriptor, buffer, sizeof(buffer));
+          if (bytesRead > 0)
+          {
+              consume(buffer, static_cast<std::size_t>(bytesRead));
+          }
+          else if (bytesRead == 0 || errno == EIO) // EIO: the other end of a pseudo-terminal has closed.
+          {
+              finish();
+              return false;
+          }
+          else if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+              return true;
+          }
+          else if (errno != EINTR)
+          {
+              throw std::system_error(errno, std::generic_category(), "Failed to read NMEA stream");
+          }
+      }
+  }
+
+  void NMEAStreamReader::processLine(const char * begin, const char * end)
+  {
+      if (begin != end && *(end-1) == '\r') --end; // Tolerate DOS line endings.
+
+      const std::string sentence(begin, end);
+      if (!isValidSentence(sentence)) return;
+
+      NMEAFix fix = { Position(0,0), false, -1 };
+      try
+      {
+          fix = extractFix(decomposeSentence(sentence));
+      }
+      catch (const std::logic_error &)
+      {
+          // Unsupported or ill-formed sentences are ignored, as in routeFromNMEALog().
+          return;
+      }
+
+      // Outside the try block, so that exceptions thrown by the handler are not swallowed.
+      handler(fix);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////
+
+  NMEAStreamPoller::NMEAStreamPoller()
+      : epollDescriptor(::epoll_create1(EPOLL_CLOEXEC))
+  {
+      if (epollDescriptor < 0)
+          throw std::system_error(errno, std::generic_category(), "Failed to create epoll instance");
+  }
+
+  NMEAStreamPoller::~NMEAStreamPoller()
+  {
+      ::close(epollDescriptor);
+  }
+
+  void NMEAStreamPoller::add(int fileDescriptor, NMEAStreamReader::PositionHandler handler)
+  {
+      addReader(fileDescriptor, new NMEAStreamReader(handler));
+  }
+
+  void NMEAStreamPoller::add(int fileDescriptor, NMEAStreamReader::FixHandler handler)
+  {
+      addReader(fileDescriptor, new NMEAStreamReader(handler));
+  }
+
+  void NMEAStreamPoller::addReader(int fileDescriptor, NMEAStreamReader * reader)
+  {
+      std::unique_ptr<NMEAStreamReader> owned(reader);
+
+      epoll_event event = {};
+      event.events = EPOLLIN;
+      event.data.fd = fileDescriptor;
+      if (::epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, fileDescriptor, &event) != 0)
+          throw std::system_error(errno, std::generic_category(), "Failed to register NMEA stream");
+
+      readers[fileDescriptor] = std::move(owned);
+  }
+
+  std::size_t NMEAStreamPoller::numStreams() const
+  {
+      return readers.size();
+  }
+
+  unsigned int NMEAStreamPoller::poll(int timeout)
+  {
+      const int maxEvents = 64;
+      epoll_event events[maxEvents];
+
+      int numEvents;
+      do
+      {
+          numEvents = ::epoll_wait(epollDescriptor, events, maxEvents, timeout);
+      }
+      while (numEvents < 0 && errno == EINTR);
+
+      if (numEvents < 0)
+          throw std::system_error(errno, std::generic_category(), "Failed to poll NMEA streams");
+
+      for (int i = 0; i < numEvents; ++i)
+      {
+          const int fileDescriptor = events[i].data.fd;
+          if (!readers.at(fileDescriptor)->readFrom(fileDescriptor)) remove(fileDescriptor);
+      }
+      return static_cast<unsigned int>(numEvents);
+  }
+
+  void NMEAStreamPoller::remove(int fileDescriptor)
+  {
+      ::epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, fileDescriptor, nullptr);
+      readers.erase(fileDescriptor);
+  }
+}
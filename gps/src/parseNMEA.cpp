@@ -0,0 +1,320 @@
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+#include "parseNMEA.h"
+
+namespace GPS
+{
+  namespace
+  {
+      /* Talker IDs and sentence formats are packed into integers, so that they can be
+       * dispatched with a switch rather than by comparing strings.
+       */
+      constexpr std::uint32_t packTalker(char c1, char c2)
+      {
+          return (static_cast<std::uint32_t>(static_cast<unsigned char>(c1)) << 8)
+                 | static_cast<unsigned char>(c2);
+      }
+
+      constexpr std::uint32_t packFormat(char c1, char c2, char c3)
+      {
+          return (static_cast<std::uint32_t>(static_cast<unsigned char>(c1)) << 16)
+                 | (static_cast<std::uint32_t>(static_cast<unsigned char>(c2)) << 8)
+                 | static_cast<unsigned char>(c3);
+      }
+
+      bool isSupportedTalker(char c1, char c2)
+      {
+          switch (packTalker(c1,c2))
+          {
+              case packTalker('G','P'): // GPS
+              case packTalker('G','N'): // Combined GNSS
+              case packTalker('G','L'): // GLONASS
+              case packTalker('G','A'): // Galileo
+              case packTalker('G','B'): // BeiDou
+                  return true;
+              default:
+                  return false;
+          }
+      }
+
+      SentenceFormat formatOf(char c1, char c2, char c3)
+      {
+          switch (packFormat(c1,c2,c3))
+          {
+              case packFormat('G','L','L'): return SentenceFormat::GLL;
+              case packFormat('G','G','A'): return SentenceFormat::GGA;
+              case packFormat('R','M','C'): return SentenceFormat::RMC;
+              case packFormat('V','T','G'): return SentenceFormat::VTG;
+              case packFormat('G','S','A'): return SentenceFormat::GSA;
+              case packFormat('G','S','V'): return SentenceFormat::GSV;
+              default:                      return SentenceFormat::Unsupported;
+          }
+      }
+
+      /* The positions of the fields from which each quantity is extracted, for each format.
+       * A negative index means that the format does not contain that quantity.
+       */
+      struct FieldLayout
+      {
+          int latitude, northing, longitude, easting, elevation; // GLL, GGA, RMC
+          int time;                                              // GLL, GGA, RMC
+          int course, speedKnots;                                // VTG, RMC
+          int fixType, pdop, hdop, vdop;                         // GSA
+          int satellitesInView, firstSatellite;                  // GSV (4 fields per satellite)
+      };
+
+      const FieldLayout layouts[] =
+      {
+          /* GLL */ {  0,  1,  2,  3, -1,   4,   -1, -1,   -1, -1, -1, -1,   -1, -1 },
+          /* GGA */ {  1,  2,  3,  4,  8,   0,   -1, -1,   -1, -1, -1, -1,   -1, -1 },
+          /* RMC */ {  2,  3,  4,  5, -1,   0,    7,  6,   -1, -1, -1, -1,   -1, -1 },
+          /* VTG */ { -1, -1, -1, -1, -1,  -1,    0,  4,   -1, -1, -1, -1,   -1, -1 },
+          /* GSA */ { -1, -1, -1, -1, -1,  -1,   -1, -1,    1, 14, 15, 16,   -1, -1 },
+          /* GSV */ { -1, -1, -1, -1, -1,  -1,   -1, -1,   -1, -1, -1, -1,    2,  3 }
+      };
+
+      const FieldLayout & layoutOf(const NMEAPair & decomposed)
+      {
+          const SentenceFormat format = sentenceFormat(decomposed.first);
+          if (format == SentenceFormat::Unsupported)
+              throw std::invalid_argument("Unsupported NMEA sentence type: " + decomposed.first);
+          return layouts[static_cast<int>(format)];
+      }
+
+      void requireField(int index, const std::string & sentenceType, const std::string & quantity)
+      {
+          if (index < 0)
+              throw std::invalid_argument("NMEA " + sentenceType + " sentences do not contain " + quantity + ".");
+      }
+
+      int hexValue(char c)
+      {
+          if (c >= '0' && c <= '9') return c - '0';
+          if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+          if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+          return -1;
+      }
+
+      const std::string & field(const std::vector<std::string> & fields, int index)
+      {
+          if (index >= static_cast<int>(fields.size()))
+              throw std::invalid_argument("Missing fields in NMEA sentence.");
+          return fields[index];
+      }
+
+      // An optional sign, followed by digits with at most one decimal point.
+      bool isDecimal(const std::string & value)
+      {
+          std::size_t i = (!value.empty() && (value[0] == '+' || value[0] == '-')) ? 1 : 0;
+          bool hasDigits = false;
+          bool hasPoint = false;
+          for (; i < value.size(); ++i)
+          {
+              if (value[i] >= '0' && value[i] <= '9') hasDigits = true;
+              else if (value[i] == '.' && !hasPoint) hasPoint = true;
+              else return false;
+          }
+          return hasDigits;
+      }
+
+      /* Fields must be entirely decimal, rather than merely starting with a number; this also
+       * rules out the "nan", "inf" and hexadecimal forms that strtod() accepts.  Values that
+       * overflow or underflow a double are rejected too, as std::stod() would throw
+       * std::out_of_range for them.
+       */
+      double decimalValue(const std::string & value)
+      {
+          if (isDecimal(value))
+          {
+              errno = 0;
+              const double result = std::strtod(value.c_str(), nullptr);
+              if (errno != ERANGE) return result;
+          }
+          throw std::invalid_argument("'" + value + "' is not a numeric NMEA field.");
+      }
+
+      const std::string & numericField(const std::vector<std::string> & fields, int index)
+      {
+          const std::string & value = field(fields, index);
+          decimalValue(value);
+          return value;
+      }
+
+      double decimalField(const std::vector<std::string> & fields, int index)
+      {
+          return decimalValue(field(fields, index));
+      }
+
+      unsigned int unsignedField(const std::vector<std::string> & fields, int index)
+      {
+          const std::string & value = field(fields, index);
+          if (value.empty() || value.size() > 9 || value.find_first_not_of("0123456789") != std::string::npos)
+              throw std::invalid_argument("'" + value + "' is not an unsigned integer NMEA field.");
+          return static_cast<unsigned int>(std::strtoul(value.c_str(), nullptr, 10));
+      }
+
+      char bearingField(const std::vector<std::string> & fields, int index)
+      {
+          const std::string & value = field(fields, index);
+          if (value.size() != 1)
+              throw std::invalid_argument("'" + value + "' is not a bearing character.");
+          return value[0];
+      }
+  }
+
+  SentenceFormat sentenceFormat(const std::string & sentenceType)
+  {
+      if (sentenceType.size() != 5 || !isSupportedTalker(sentenceType[0], sentenceType[1]))
+      {
+          return SentenceFormat::Unsupported;
+      }
+      return formatOf(sentenceType[2], sentenceType[3], sentenceType[4]);
+  }
+
+  bool isValidSentence(const std::string & sentence)
+  {
+      // Shortest valid sentence: "$", talker, format, ",", "*", checksum.
+      const std::size_t minLength = 1 + 2 + 3 + 1 + 1 + 2;
+      if (sentence.size() < minLength) return false;
+      if (sentence[0] != '$' || !isSupportedTalker(sentence[1], sentence[2])) return false;
+
+      for (std::size_t i = 3; i < 6; ++i)
+      {
+          if (sentence[i] < 'A' || sentence[i] > 'Z') return false;
+      }
+      if (sentence[6] != ',') return false;
+
+      const std::size_t checksumStart = sentence.size() - 2;
+      if (sentence[checksumStart - 1] != '*') return false;
+
+      unsigned char checksum = 0;
+      for (std::size_t i = 1; i < checksumStart - 1; ++i)
+      {
+          if (sentence[i] == '*' || sentence[i] == '$') return false;
+          checksum ^= static_cast<unsigned char>(sentence[i]);
+      }
+
+      const int high = hexValue(sentence[checksumStart]);
+      const int low = hexValue(sentence[checksumStart + 1]);
+      return high >= 0 && low >= 0 && checksum == high * 16 + low;
+  }
+
+  NMEAPair decomposeSentence(const std::string & nmeaSentence)
+  {
+      const std::size_t fieldsStart = nmeaSentence.find(',') + 1;
+      const std::size_t fieldsEnd = nmeaSentence.rfind('*');
+
+      NMEAPair decomposed;
+      decomposed.first = nmeaSentence.substr(1, fieldsStart - 2);
+
+      std::size_t start = fieldsStart;
+      while (true)
+      {
+          const std::size_t comma = nmeaSentence.find(',', start);
+          if (comma == std::string::npos || comma > fieldsEnd)
+          {
+              decomposed.second.push_back(nmeaSentence.substr(start, fieldsEnd - start));
+              return decomposed;
+          }
+          decomposed.second.push_back(nmeaSentence.substr(start, comma - start));
+          start = comma + 1;
+      }
+  }
+
+  Position extractPosition(const NMEAPair & decomposed)
+  {
+      const FieldLayout & layout = layoutOf(decomposed);
+      requireField(layout.latitude, decomposed.first, "a position");
+
+      const std::vector<std::string> & fields = decomposed.second;
+      return Position(numericField(fields, layout.latitude), bearingField(fields, layout.northing),
+                      numericField(fields, layout.longitude), bearingField(fields, layout.easting),
+                      (layout.elevation < 0) ? "0" : numericField(fields, layout.elevation));
+  }
+
+  NMEAFix extractFix(const NMEAPair & decomposed)
+  {
+      const FieldLayout & layout = layoutOf(decomposed);
+      const Position position = extractPosition(decomposed);
+
+      // "hhmmss.sss"
+      double timeOfDay = -1;
+      const std::vector<std::string> & fields = decomposed.second;
+      if (layout.time >= 0 && layout.time < static_cast<int>(fields.size()) && isDecimal(fields[layout.time]))
+      {
+          const double hhmmss = std::strtod(fields[layout.time].c_str(), nullptr);
+          if (hhmmss >= 0 && hhmmss < 240000)
+          {
+              timeOfDay = std::floor(hhmmss / 10000) * 3600
+                          + std::fmod(std::floor(hhmmss / 100), 100) * 60
+                          + std::fmod(hhmmss, 100);
+          }
+      }
+      return { position, layout.elevation >= 0, timeOfDay };
+  }
+
+  CourseOverGround extractCourse(const NMEAPair & decomposed)
+  {
+      const FieldLayout & layout = layoutOf(decomposed);
+      requireField(layout.course, decomposed.first, "a course");
+
+      const std::vector<std::string> & fields = decomposed.second;
+      return { decimalField(fields, layout.course), decimalField(fields, layout.speedKnots) };
+  }
+
+  DilutionOfPrecision extractDilution(const NMEAPair & decomposed)
+  {
+      const FieldLayout & layout = layoutOf(decomposed);
+      requireField(layout.fixType, decomposed.first, "a dilution of precision");
+
+      const std::vector<std::string> & fields = decomposed.second;
+      return { unsignedField(fields, layout.fixType), decimalField(fields, layout.pdop),
+               decimalField(fields, layout.hdop), decimalField(fields, layout.vdop) };
+  }
+
+  SatellitesInView extractSatellites(const NMEAPair & decomposed)
+  {
+      const FieldLayout & layout = layoutOf(decomposed);
+      requireField(layout.satellitesInView, decomposed.first, "satellites in view");
+
+      const std::vector<std::string> & fields = decomposed.second;
+      SatellitesInView inView;
+      inView.numSatellites = unsignedField(fields, layout.satellitesInView);
+
+      // Each satellite is described by 4 fields; trailing empty fields pad the final sentence.
+      for (std::size_t i = layout.firstSatellite; i + 3 < fields.size() && !fields[i].empty(); i += 4)
+      {
+          const int id = static_cast<int>(i);
+          inView.satellites.push_back({ unsignedField(fields, id), decimalField(fields, id+1), decimalField(fields, id+2),
+                                        fields[i+3].empty() ? -1 : static_cast<int>(unsignedField(fields, id+3)) });
+      }
+      return inView;
+  }
+
+  std::vector<Position> routeFromNMEALog(const std::string & filepath)
+  {
+      std::vector<Position> route;
+      std::ifstream log(filepath);
+      std::string sentence;
+      while (std::getline(log, sentence))
+      {
+          if (!sentence.empty() && sentence.back() == '\r') sentence.pop_back(); // Tolerate DOS line endings.
+          if (!isValidSentence(sentence)) continue;
+
+          try
+          {
+              route.push_back(extractPosition(decomposeSentence(sentence)));
+          }
+          catch (const std::logic_error &) // std::invalid_argument or std::out_of_range
+          {
+              // Ill-formed or unsupported sentences are ignored.
+          }
+      }
+      return route;
+  }
+}
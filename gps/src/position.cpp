@@ -4,23 +4,11 @@
 
 #include "geometry.h"
 #include "earth.h"
+#include "distance.h"
 #include "position.h"
 
 namespace GPS
 {
-  Position::Position(degrees lat, degrees lon, metres ele)
-  {
-      if (std::abs(lat) > poleLatitude)
-          throw std::invalid_argument("Latitude values must not exceed " + std::to_string(poleLatitude) + " degrees.");
-
-      if (std::abs(lon) > antiMeridianLongitude)
-          throw std::invalid_argument("Longitude values must not exceed " + std::to_string(antiMeridianLongitude) + " degrees.");
-
-      this->lat = lat;
-      this->lon = lon;
-      this->ele = ele;
-  }
-
   Position::Position(const std::string & latStr,
                      const std::string & lonStr,
                      const std::string & eleStr)
@@ -53,21 +41,6 @@ namespace GPS
 
   }
 
-  degrees Position::latitude() const
-  {
-      return lat;
-  }
-
-  degrees Position::longitude() const
-  {
-      return lon;
-  }
-
-  metres Position::elevation() const
-  {
-      return ele;
-  }
-
   std::string Position::toString(bool includeElevation) const
   {
       std::ostringstream oss;
@@ -82,17 +55,8 @@ namespace GPS
   }
 
   metres Position::distanceBetween(const Position & p1, const Position & p2)
-  /*
-   * See: http://en.wikipedia.org/wiki/Law_of_haversines
-   */
   {
-      const radians lat1 = degToRad(p1.latitude());
-      const radians lat2 = degToRad(p2.latitude());
-      const radians lon1 = degToRad(p1.longitude());
-      const radians lon2 = degToRad(p2.longitude());
-
-      double h = sinSqr((lat2-lat1)/2) + std::cos(lat1)*std::cos(lat2)*sinSqr((lon2-lon1)/2);
-      return 2 * Earth::meanRadius * std::asin(sqrt(h));
+      return Distance::Haversine::between(p1,p2);
   }
 
   degrees ddmTodd(const std::string & ddmStr)
@@ -0,0 +1,251 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "earth.h"
+#include "logs.h"
+#include "distance.h"
+#include "projection.h"
+#include "parseNMEA.h"
+#include "nmeaStream.h"
+#include "positionFilter.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( KalmanSmoothing )
+
+const metres metreAccuracy = 1;
+
+// Fixes scattered about Earth::CityCampus, with Gaussian errors of "noise" metres.
+static std::vector<Position> jitterInPlace(unsigned int numFixes, metres noise)
+{
+    const LocalProjection projection(Earth::CityCampus);
+    std::mt19937 generator(181026);
+    std::normal_distribution<double> error(0, noise);
+
+    std::vector<Position> fixes;
+    for (unsigned int i = 0; i < numFixes; ++i)
+    {
+        const PlanePoint p = { error(generator), error(generator) };
+        fixes.push_back(projection.fromPlane(p, Earth::CityCampus.elevation() + error(generator)));
+    }
+    return fixes;
+}
+
+// Exact fixes heading North-East from Earth::CityCampus, "step" metres apart along each axis.
+static std::vector<Position> straightLine(unsigned int numFixes, metres step)
+{
+    const LocalProjection projection(Earth::CityCampus);
+    std::vector<Position> fixes;
+    for (unsigned int i = 0; i < numFixes; ++i)
+    {
+        fixes.push_back(projection.fromPlane({ i * step, i * step }, Earth::CityCampus.elevation()));
+    }
+    return fixes;
+}
+
+BOOST_AUTO_TEST_CASE( StationaryJitterIsSuppressed )
+{
+    const std::vector<Position> fixes = jitterInPlace(200, 3);
+    PositionFilter filter;
+
+    // After the filter has settled, compare the RMS errors of the raw and filtered fixes.
+    unsigned int numStationary = 0;
+    metres rawSumSqr = 0;
+    metres filteredSumSqr = 0;
+    for (unsigned int i = 0; i < fixes.size(); ++i)
+    {
+        const FilteredPosition filtered = filter.update(fixes[i]);
+        if (i < 20) continue;
+
+        numStationary += filtered.stationary;
+        rawSumSqr += std::pow(Position::distanceBetween(fixes[i], Earth::CityCampus), 2);
+        filteredSumSqr += std::pow(Position::distanceBetween(filtered.position, Earth::CityCampus), 2);
+    }
+    BOOST_CHECK_GT( numStationary , 150 );
+    BOOST_CHECK_LT( filteredSumSqr , rawSumSqr / 4 );
+    BOOST_CHECK_EQUAL( filter.numFixes() , 200 );
+
+    const std::vector<Position> route = filterRoute(fixes);
+    BOOST_CHECK_LT( pathLength(route) , pathLength(fixes) / 20 );
+}
+
+BOOST_AUTO_TEST_CASE( ConstantVelocityIsTracked )
+{
+    const std::vector<Position> fixes = straightLine(50, 10);
+    PositionFilter filter;
+    for (unsigned int i = 0; i < fixes.size(); ++i)
+    {
+        const FilteredPosition filtered = filter.update(fixes[i]);
+        if (i >= 5)
+        {
+            BOOST_CHECK( !filtered.stationary );
+            BOOST_CHECK_SMALL( Position::distanceBetween(filtered.position, fixes[i]) , metreAccuracy );
+        }
+    }
+    BOOST_CHECK_EQUAL( filterRoute(fixes).size() , fixes.size() );
+}
+
+BOOST_AUTO_TEST_CASE( LongJourneys )
+{
+    // 200 fixes 100m apart along each axis cover ~28km, so the projection origin is moved several times.
+    const std::vector<Position> fixes = straightLine(200, 100);
+    PositionFilter filter;
+    FilteredPosition filtered = { Earth::CityCampus, true, false };
+    for (const Position & fix : fixes) filtered = filter.update(fix);
+
+    BOOST_CHECK( !filtered.stationary );
+    BOOST_CHECK_SMALL( Position::distanceBetween(filtered.position, fixes.back()) , metreAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( Reset )
+{
+    PositionFilter filter;
+    for (const Position & fix : straightLine(10, 10)) filter.update(fix);
+
+    filter.reset();
+    BOOST_CHECK_EQUAL( filter.numFixes() , 0 );
+
+    const FilteredPosition filtered = filter.update(Earth::CliftonCampus);
+    BOOST_CHECK_EQUAL( filtered.position.latitude() , Earth::CliftonCampus.latitude() );
+    BOOST_CHECK_EQUAL( filtered.position.longitude() , Earth::CliftonCampus.longitude() );
+    BOOST_CHECK_EQUAL( filtered.position.elevation() , Earth::CliftonCampus.elevation() );
+    BOOST_CHECK( !filtered.stationary );
+}
+
+BOOST_AUTO_TEST_CASE( FixesWithoutElevations )
+{
+    // Alternating GGA (with elevations) and RMC (without) sentences, one pair per epoch.
+    const std::vector<Position> positions = straightLine(40, 10);
+    std::vector<NMEAFix> fixes;
+    for (unsigned int i = 0; i < positions.size(); ++i)
+    {
+        const Position & pos = positions[i];
+        fixes.push_back({ Position(pos.latitude(), pos.longitude(), 30), true, 1.0 * i });
+        fixes.push_back({ Position(pos.latitude(), pos.longitude(), 0), false, 1.0 * i });
+    }
+
+    PositionFilter filter;
+    for (const NMEAFix & fix : fixes)
+    {
+        const FilteredPosition filtered = filter.update(fix);
+        BOOST_CHECK_CLOSE( filtered.position.elevation() , 30 , 0.0001 );
+    }
+
+    // An initial fix without an elevation does not anchor the elevation estimate.
+    filter.reset();
+    filter.update(fixes[1]);
+    BOOST_CHECK_CLOSE( filter.update(fixes[2]).position.elevation() , 30 , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( FixesFromTheSameEpochAreMerged )
+{
+    const std::vector<Position> positions = straightLine(20, 10);
+    std::vector<NMEAFix> fixes;
+    for (unsigned int i = 0; i < positions.size(); ++i)
+    {
+        fixes.push_back({ positions[i], true, 1.0 * i });
+        fixes.push_back({ positions[i], false, 1.0 * i });
+    }
+
+    PositionFilter filter;
+    for (unsigned int i = 0; i < fixes.size(); ++i)
+    {
+        const FilteredPosition filtered = filter.update(fixes[i]);
+        BOOST_CHECK_EQUAL( filtered.sameEpoch , i % 2 == 1 );
+        if (i >= 10) BOOST_CHECK( !filtered.stationary );
+    }
+    BOOST_CHECK_EQUAL( filter.numFixes() , positions.size() );
+
+    // Each epoch contributes one route point.
+    const std::vector<Position> route = filterRoute(fixes);
+    BOOST_REQUIRE_EQUAL( route.size() , positions.size() );
+    BOOST_CHECK_SMALL( Position::distanceBetween(route.back(), positions.back()) , metreAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( RefinementsOfDiscardedEpochs )
+{
+    // A stationary receiver, with a GGA sentence followed by a RMC sentence each epoch.
+    const std::vector<Position> positions = jitterInPlace(100, 3);
+    std::vector<NMEAFix> ggaOnly, ggaAndRMC;
+    for (unsigned int i = 0; i < positions.size(); ++i)
+    {
+        const Position & pos = positions[i];
+        ggaOnly.push_back({ pos, true, 1.0 * i });
+        ggaAndRMC.push_back({ pos, true, 1.0 * i });
+        ggaAndRMC.push_back({ Position(pos.latitude(), pos.longitude(), 0), false, 1.0 * i });
+    }
+
+    // The RMC sentences refine nothing, and must not move the point kept for a stationary run.
+    const std::vector<Position> route = filterRoute(ggaAndRMC);
+    BOOST_CHECK_LT( route.size() , positions.size() / 2 );
+    BOOST_CHECK( bitIdentical(route, filterRoute(ggaOnly)) );
+}
+
+BOOST_AUTO_TEST_CASE( TimeStepsFollowTimesOfDay )
+{
+    // About 1.4m per fix: a walk if fixes are a second apart, but a crawl if they are 4s apart.
+    const std::vector<Position> positions = straightLine(60, 1);
+    PositionFilter everySecond, everyFourSeconds;
+    FilteredPosition fast = { Earth::CityCampus, true, false };
+    FilteredPosition slow = { Earth::CityCampus, false, false };
+    for (unsigned int i = 0; i < positions.size(); ++i)
+    {
+        fast = everySecond.update(NMEAFix{ positions[i], true, 1.0 * i });
+        slow = everyFourSeconds.update(NMEAFix{ positions[i], true, std::fmod(86300 + 4.0 * i, 86400) }); // Past midnight.
+    }
+    BOOST_CHECK( !fast.stationary );
+    BOOST_CHECK( slow.stationary );
+    BOOST_CHECK_SMALL( Position::distanceBetween(fast.position, positions.back()) , metreAccuracy );
+    BOOST_CHECK_SMALL( Position::distanceBetween(slow.position, positions.back()) , metreAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( ChainedOntoStreamReader )
+{
+    const std::string logFile = LogFiles::NMEALogsDir + "gga_rmc.log";
+    const std::string data = fileContents(logFile);
+
+    std::vector<FilteredPosition> filtered;
+    NMEAStreamReader reader(filteredHandler([&](const FilteredPosition & pos) { filtered.push_back(pos); }));
+    reader.consume(data.data(), data.size());
+    reader.finish();
+
+    // Each epoch is a GGA sentence (with an elevation) followed by a RMC sentence (without).
+    const std::vector<Position> raw = routeFromNMEALog(logFile);
+    BOOST_REQUIRE_EQUAL( filtered.size() , raw.size() );
+
+    std::vector<Position> smoothed;
+    metres sumElevationError = 0;
+    for (std::size_t i = 0; i < filtered.size(); ++i)
+    {
+        BOOST_CHECK_EQUAL( filtered[i].sameEpoch , i % 2 == 1 );
+        if (filtered[i].sameEpoch) continue;
+
+        smoothed.push_back(filtered[i].position);
+        sumElevationError += std::abs(filtered[i].position.elevation() - raw[i].elevation());
+    }
+    BOOST_CHECK_LT( sumElevationError / smoothed.size() , 5 );
+
+    std::vector<Position> gga;
+    for (std::size_t i = 0; i < raw.size(); i += 2) gga.push_back(raw[i]);
+    BOOST_CHECK_LT( pathLength(smoothed) , pathLength(gga) );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidNoise )
+{
+    BOOST_CHECK_THROW( PositionFilter(0) , std::invalid_argument );
+    BOOST_CHECK_THROW( PositionFilter(5, -1) , std::invalid_argument );
+    BOOST_CHECK_THROW( PositionFilter(5, 1, 0) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
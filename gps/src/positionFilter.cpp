@@ -0,0 +1,208 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "positionFilter.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // The initial speed is unknown, so start with a large uncertainty (in metres per second).
+      constexpr double initialSpeedVariance = 100 * 100;
+
+      constexpr double secondsPerDay = 24 * 60 * 60;
+
+      // Fixes without a time of day are taken to be this long after their predecessors.
+      constexpr double defaultTimeStep = 1;
+
+      // Move the projection origin when the receiver is further than this from it.
+      constexpr metres maxDistanceFromOrigin = 5000;
+  }
+
+  PositionFilter::PositionFilter(metres measurementNoise,
+                                 metres accelerationNoise,
+                                 metres verticalNoise,
+                                 metres stationarySpeed)
+      : horizontalVariance(measurementNoise * measurementNoise),
+        accelerationVariance(accelerationNoise * accelerationNoise),
+        verticalVariance(verticalNoise * verticalNoise),
+        stationarySpeed(stationarySpeed),
+        projection(Position(0,0)),
+        east{0,0}, north{0,0}, up{0,0},
+        horizontal{0,0,0}, vertical{0,0,0}
+  {
+      if (!(measurementNoise > 0) || !(accelerationNoise > 0) || !(verticalNoise > 0))
+          throw std::invalid_argument("Position filter noise levels must be positive.");
+  }
+
+  FilteredPosition PositionFilter::update(const NMEAFix & fix)
+  {
+      if (fixes == 0)
+      {
+          start(fix);
+          return { fix.position, false, false };
+      }
+
+      if (fix.timeOfDay >= 0 && fix.timeOfDay == epochTime)
+      {
+          // Another sentence from the same epoch; its horizontal position is not a new measurement.
+          if (fix.hasElevation && !epochHasElevation)
+          {
+              correctElevation(fix.position.elevation());
+              epochHasElevation = true;
+          }
+          return estimate(true);
+      }
+      double timeStep = defaultTimeStep;
+      if (fix.timeOfDay >= 0 && epochTime >= 0)
+      {
+          timeStep = fix.timeOfDay - epochTime;
+          if (timeStep < 0) timeStep += secondsPerDay; // The times of day have passed midnight.
+      }
+      ++fixes;
+      epochTime = fix.timeOfDay;
+      epochHasElevation = fix.hasElevation;
+
+      // Predict.
+      for (AxisState * axis : { &east, &north, &up }) axis->position += axis->speed * timeStep;
+      horizontal = predict(horizontal, timeStep, accelerationVariance);
+      vertical = predict(vertical, timeStep, accelerationVariance);
+
+      // Correct.
+      const PlanePoint measured = projection.toPlane(fix.position);
+      const double innovationVariance = horizontal.pp + horizontalVariance;
+      const double gain0 = horizontal.pp / innovationVariance;
+      const double gain1 = horizontal.pv / innovationVariance;
+      correct(east, measured.x, gain0, gain1);
+      correct(north, measured.y, gain0, gain1);
+      correct(horizontal, gain0, gain1);
+
+      if (fix.hasElevation) correctElevation(fix.position.elevation());
+
+      const FilteredPosition smoothed = estimate(false);
+      if (std::hypot(east.position, north.position) > maxDistanceFromOrigin)
+      {
+          // Speeds are unaffected, to within the accuracy of the projection.
+          projection = LocalProjection(smoothed.position);
+          east.position = 0;
+          north.position = 0;
+      }
+      return smoothed;
+  }
+
+  FilteredPosition PositionFilter::update(const Position & fix)
+  {
+      return update(NMEAFix{ fix, true, -1 });
+  }
+
+  void PositionFilter::reset()
+  {
+      fixes = 0;
+  }
+
+  unsigned int PositionFilter::numFixes() const
+  {
+      return fixes;
+  }
+
+  void PositionFilter::start(const NMEAFix & fix)
+  {
+      fixes = 1;
+      epochTime = fix.timeOfDay;
+      epochHasElevation = hasElevation = fix.hasElevation;
+      projection = LocalProjection(fix.position);
+      east = { 0, 0 };
+      north = { 0, 0 };
+      up = { fix.position.elevation(), 0 };
+      horizontal = { horizontalVariance, 0, initialSpeedVariance };
+      vertical = { verticalVariance, 0, initialSpeedVariance }; // Reset by the first elevation, if this fix has none.
+  }
+
+  void PositionFilter::correctElevation(metres elevation)
+  {
+      if (!hasElevation)
+      {
+          // The first elevation; until now the estimate was a placeholder.
+          hasElevation = true;
+          up = { elevation, 0 };
+          vertical = { verticalVariance, 0, initialSpeedVariance };
+          return;
+      }
+      const double innovationVariance = vertical.pp + verticalVariance;
+      const double gain0 = vertical.pp / innovationVariance;
+      const double gain1 = vertical.pv / innovationVariance;
+      correct(up, elevation, gain0, gain1);
+      correct(vertical, gain0, gain1);
+  }
+
+  FilteredPosition PositionFilter::estimate(bool sameEpoch)
+  {
+      return { projection.fromPlane({ east.position, north.position }, up.position),
+               std::hypot(east.speed, north.speed) < stationarySpeed,
+               sameEpoch };
+  }
+
+  PositionFilter::Covariance PositionFilter::predict(const Covariance & p, double dt, double accelerationVariance)
+  {
+      /* The receiver is assumed to move at constant speed, subject to random accelerations.
+       * Over a time step of dt, the state transition is
+       *   [ 1 dt ]
+       *   [ 0  1 ]
+       * and the process noise (per unit of acceleration variance) is
+       *   [ dt^4/4 dt^3/2 ]
+       *   [ dt^3/2  dt^2  ]
+       */
+      const double dt2 = dt * dt;
+      return { p.pp + 2 * dt * p.pv + dt2 * p.vv + dt2 * dt2 / 4 * accelerationVariance,
+               p.pv + dt * p.vv + dt2 * dt / 2 * accelerationVariance,
+               p.vv + dt2 * accelerationVariance };
+  }
+
+  void PositionFilter::correct(AxisState & axis, metres measured, double gain0, double gain1)
+  {
+      const metres innovation = measured - axis.position;
+      axis.position += gain0 * innovation;
+      axis.speed += gain1 * innovation;
+  }
+
+  void PositionFilter::correct(Covariance & p, double gain0, double gain1)
+  {
+      p = { (1 - gain0) * p.pp,
+            (1 - gain0) * p.pv,
+            p.vv - gain1 * p.pv };
+  }
+
+  NMEAStreamReader::FixHandler filteredHandler(PositionFilter::FilteredPositionHandler handler,
+                                               PositionFilter filter)
+  {
+      return [handler, filter](const NMEAFix & fix) mutable { handler(filter.update(fix)); };
+  }
+
+  std::vector<Position> filterRoute(const std::vector<NMEAFix> & fixes, PositionFilter filter)
+  {
+      std::vector<Position> route;
+      bool wasStationary = false;
+      bool epochKept = false; // Was the current epoch's estimate added to the route?
+      for (const NMEAFix & fix : fixes)
+      {
+          const FilteredPosition filtered = filter.update(fix);
+          if (filtered.sameEpoch)
+          {
+              if (epochKept) route.back() = filtered.position; // Refined.
+              continue;
+          }
+          epochKept = route.empty() || !filtered.stationary || !wasStationary;
+          if (epochKept) route.push_back(filtered.position);
+          wasStationary = filtered.stationary;
+      }
+      return route;
+  }
+
+  std::vector<Position> filterRoute(const std::vector<Position> & fixes, PositionFilter filter)
+  {
+      std::vector<NMEAFix> withElevations;
+      withElevations.reserve(fixes.size());
+      for (const Position & fix : fixes) withElevations.push_back({ fix, true, -1 });
+      return filterRoute(withElevations, filter);
+  }
+}
@@ -0,0 +1,158 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "earth.h"
+#include "routeCache.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteCaching )
+
+// Counts its calls, and returns a route with one point per byte of the file.
+struct CountingLoader
+{
+    std::atomic<int> & calls;
+
+    RouteSnapshot operator()(const std::string & filepath, metres granularity) const
+    {
+        ++calls;
+        std::ifstream file(filepath);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return RouteSnapshot(filepath, std::vector<Position>(contents.size(), Earth::CityCampus),
+                             std::vector<std::string>(contents.size()), granularity);
+    }
+};
+
+BOOST_AUTO_TEST_CASE( RepeatedLoadsAreServedFromCache )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    const TempFile file("abc");
+
+    const RouteSnapshot first = cache.get(file.path, 20);
+    const RouteSnapshot second = cache.get(file.path, 20);
+    BOOST_CHECK_EQUAL( calls.load() , 1 );
+    BOOST_CHECK( second.sharesStorageWith(first) );
+    BOOST_CHECK_EQUAL( cache.hits() , 1 );
+    BOOST_CHECK_EQUAL( cache.misses() , 1 );
+    BOOST_CHECK_EQUAL( cache.numEntries() , 1 );
+    BOOST_CHECK( cache.sizeBytes() >= first.storageBytes() );
+}
+
+BOOST_AUTO_TEST_CASE( GranularityIsPartOfKey )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    const TempFile file("abc");
+
+    BOOST_CHECK_EQUAL( cache.get(file.path, 20).granularity() , 20 );
+    BOOST_CHECK_EQUAL( cache.get(file.path, 50).granularity() , 50 );
+    BOOST_CHECK_EQUAL( calls.load() , 2 );
+}
+
+BOOST_AUTO_TEST_CASE( ModifiedFilesAreReloaded )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    const TempFile file("abc");
+
+    BOOST_CHECK_EQUAL( cache.get(file.path, 20).numPositions() , 3 );
+    file.write("abcdef");
+    BOOST_CHECK_EQUAL( cache.get(file.path, 20).numPositions() , 6 );
+    BOOST_CHECK_EQUAL( calls.load() , 2 );
+
+    // The stale entry is replaced, not left to be evicted.
+    BOOST_CHECK_EQUAL( cache.numEntries() , 1 );
+    RouteCache fresh(1024 * 1024, CountingLoader{calls});
+    fresh.get(file.path, 20);
+    BOOST_CHECK_EQUAL( cache.sizeBytes() , fresh.sizeBytes() );
+}
+
+BOOST_AUTO_TEST_CASE( LeastRecentlyUsedAreEvicted )
+{
+    std::atomic<int> calls(0);
+    const TempFile file1(std::string(1000, 'x')), file2(std::string(1000, 'y')), file3(std::string(1000, 'z'));
+    RouteCache probe(1024 * 1024, CountingLoader{calls});
+    probe.get(file1.path, 20);
+    const std::size_t entryBytes = probe.sizeBytes();
+    BOOST_CHECK( entryBytes > probe.get(file1.path, 20).storageBytes() ); // The path is counted too.
+
+    RouteCache cache(2 * entryBytes + entryBytes / 2, CountingLoader{calls});
+    cache.get(file1.path, 20);
+    cache.get(file2.path, 20);
+    cache.get(file1.path, 20); // file2 is now the least recently used.
+    cache.get(file3.path, 20);
+    BOOST_CHECK_EQUAL( cache.numEntries() , 2 );
+    BOOST_CHECK( cache.sizeBytes() <= cache.capacityBytes() );
+
+    calls = 0;
+    cache.get(file1.path, 20);
+    cache.get(file3.path, 20);
+    BOOST_CHECK_EQUAL( calls.load() , 0 );
+    cache.get(file2.path, 20);
+    BOOST_CHECK_EQUAL( calls.load() , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( PathsAreCanonicalised )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    const TempFile file("abc");
+    const std::string::size_type slash = file.path.rfind('/');
+    const std::string directory = file.path.substr(0, slash), name = file.path.substr(slash + 1);
+
+    const RouteSnapshot first = cache.get(file.path, 20);
+    BOOST_CHECK( cache.get(directory + "/./" + name, 20).sharesStorageWith(first) );
+    BOOST_CHECK( cache.get(directory + "/../" + directory.substr(1) + "//" + name, 20).sharesStorageWith(first) );
+    BOOST_CHECK_EQUAL( calls.load() , 1 );
+    BOOST_CHECK_EQUAL( cache.numEntries() , 1 );
+}
+
+BOOST_AUTO_TEST_CASE( MissingFilesAreNotCached )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    cache.get("/tmp/no-such-route-file.gpx", 20);
+    cache.get("/tmp/no-such-route-file.gpx", 20);
+    BOOST_CHECK_EQUAL( calls.load() , 2 );
+    BOOST_CHECK_EQUAL( cache.numEntries() , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentAccess )
+{
+    std::atomic<int> calls(0);
+    RouteCache cache(1024 * 1024, CountingLoader{calls});
+    const TempFile file1("abc"), file2("abcdef");
+
+    std::atomic<int> wrongSizes(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int i = 0; i < 500; ++i)
+            {
+                if (cache.get(file1.path, 20).numPositions() != 3) ++wrongSizes;
+                if (cache.get(file2.path, 20).numPositions() != 6) ++wrongSizes;
+            }
+        });
+    }
+    for (std::thread & thread : threads) thread.join();
+
+    BOOST_CHECK_EQUAL( wrongSizes.load() , 0 );
+    BOOST_CHECK_EQUAL( cache.numEntries() , 2 );
+    BOOST_CHECK_EQUAL( cache.hits() + cache.misses() , 8000 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,148 @@
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+#include <sys/stat.h>
+
+#include "routeCache.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // The absolute path with symbolic links and "." and ".." components resolved, or the path as given if it cannot be resolved.
+      std::string canonicalPath(const std::string & filepath)
+      {
+          char * const resolved = ::realpath(filepath.c_str(), nullptr);
+          if (resolved == nullptr) return filepath;
+          const std::string canonical = resolved;
+          std::free(resolved);
+          return canonical;
+      }
+  }
+
+  RouteCache::RouteCache(std::size_t capacityBytes, Loader loader)
+      : capacity(capacityBytes), loader(loader) {}
+
+  RouteSnapshot RouteCache::get(const std::string & filepath, metres granularity)
+  {
+      struct stat status;
+      if (::stat(filepath.c_str(), &status) != 0)
+      {
+          {
+              std::lock_guard<std::mutex> lock(mutex);
+              ++numMisses;
+          }
+          return loader(filepath, granularity);
+      }
+
+#ifdef __linux__
+      const long long modifiedTime = status.st_mtim.tv_sec * 1000000000LL + status.st_mtim.tv_nsec;
+#else
+      const long long modifiedTime = status.st_mtime * 1000000000LL;
+#endif
+      const Key key = { canonicalPath(filepath), granularity };
+      const FileStamp stamp = { static_cast<long long>(status.st_size), modifiedTime };
+
+      {
+          std::lock_guard<std::mutex> lock(mutex);
+          const auto found = index.find(key);
+          if (found != index.end() && found->second->stamp == stamp)
+          {
+              ++numHits;
+              entries.splice(entries.begin(), entries, found->second);
+              return found->second->route;
+          }
+          ++numMisses;
+      }
+
+      const RouteSnapshot route = loader(filepath, granularity);
+      const std::size_t bytes = route.storageBytes() + key.filepath.capacity();
+
+      std::lock_guard<std::mutex> lock(mutex);
+      const auto found = index.find(key);
+      if (found != index.end())
+      {
+          // Another thread may have loaded the same, or a newer, version meanwhile.
+          if (found->second->stamp == stamp || found->second->stamp.modifiedTime > stamp.modifiedTime) return route;
+          erase(found->second); // Stale.
+      }
+      if (bytes > capacity) return route;
+
+      const auto inserted = index.emplace(key, entries.end()).first;
+      entries.push_front({ &inserted->first, stamp, route, bytes });
+      inserted->second = entries.begin();
+      totalBytes += bytes;
+      evictToFit();
+      return route;
+  }
+
+  void RouteCache::clear()
+  {
+      std::lock_guard<std::mutex> lock(mutex);
+      index.clear();
+      entries.clear();
+      totalBytes = 0;
+  }
+
+  std::size_t RouteCache::capacityBytes() const
+  {
+      return capacity;
+  }
+
+  std::size_t RouteCache::sizeBytes() const
+  {
+      std::lock_guard<std::mutex> lock(mutex);
+      return totalBytes;
+  }
+
+  unsigned int RouteCache::numEntries() const
+  {
+      std::lock_guard<std::mutex> lock(mutex);
+      return static_cast<unsigned int>(entries.size());
+  }
+
+  unsigned long RouteCache::hits() const
+  {
+      std::lock_guard<std::mutex> lock(mutex);
+      return numHits;
+  }
+
+  unsigned long RouteCache::misses() const
+  {
+      std::lock_guard<std::mutex> lock(mutex);
+      return numMisses;
+  }
+
+  void RouteCache::erase(std::list<Entry>::iterator entry)
+  {
+      totalBytes -= entry->bytes;
+      index.erase(index.find(*entry->key)); // Not erase(*entry->key), which would refer into the erased node.
+      entries.erase(entry);
+  }
+
+  void RouteCache::evictToFit()
+  {
+      while (totalBytes > capacity)
+      {
+          erase(std::prev(entries.end()));
+      }
+  }
+
+  bool RouteCache::Key::operator==(const Key & other) const
+  {
+      return filepath == other.filepath && granularity == other.granularity;
+  }
+
+  bool RouteCache::FileStamp::operator==(const FileStamp & other) const
+  {
+      return size == other.size && modifiedTime == other.modifiedTime;
+  }
+
+  std::size_t RouteCache::KeyHash::operator()(const Key & key) const
+  {
+      const std::size_t hash = std::hash<std::string>()(key.filepath);
+      return hash ^ (std::hash<metres>()(key.granularity) + 0x9E3779B9 + (hash << 6) + (hash >> 2));
+  }
+}
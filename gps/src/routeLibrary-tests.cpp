@@ -0,0 +1,103 @@
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "routeLibrary.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( FrechetDistance )
+
+const double percentageAccuracy = 0.5;
+
+BOOST_AUTO_TEST_CASE( ParallelRoutes )
+{
+    const std::vector<Position> route1 = { offset(0,0), offset(100,0), offset(200,0) };
+    const std::vector<Position> route2 = { offset(0,10), offset(100,10), offset(200,10) };
+    BOOST_CHECK_CLOSE( discreteFrechetDistance(route1, route2) , 10 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( OrderMatters )
+{
+    const std::vector<Position> route = { offset(0,0), offset(100,0), offset(200,0) };
+    const std::vector<Position> reversed = { offset(200,0), offset(100,0), offset(0,0) };
+    BOOST_CHECK_SMALL( discreteFrechetDistance(route, route) , 0.0001 );
+    BOOST_CHECK_CLOSE( discreteFrechetDistance(route, reversed) , 200 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyRoute )
+{
+    BOOST_CHECK_THROW( discreteFrechetDistance({}, { Earth::CityCampus }) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteLibrarySearch )
+
+// A 2km route heading in the specified direction, with a point every 50m, displaced sideways.
+std::vector<Position> straightRoute(double northward, double eastward, metres sideways = 0)
+{
+    std::vector<Position> route;
+    for (int i = 0; i <= 40; ++i)
+    {
+        route.push_back(offset(i * 50 * northward + sideways * eastward, i * 50 * eastward - sideways * northward));
+    }
+    return route;
+}
+
+BOOST_AUTO_TEST_CASE( FindsNearDuplicates )
+{
+    RouteLibrary library(20);
+    const RouteLibrary::RouteId north = library.add(straightRoute(1,0));
+    const RouteLibrary::RouteId east = library.add(straightRoute(0,1));
+    const RouteLibrary::RouteId northEast = library.add(straightRoute(0.6,0.8));
+    BOOST_CHECK_EQUAL( library.numRoutes() , 3 );
+
+    BOOST_CHECK( library.findSimilar(straightRoute(1,0)) == std::vector<RouteLibrary::RouteId>({north}) );
+    BOOST_CHECK( library.findSimilar(straightRoute(1,0,15)) == std::vector<RouteLibrary::RouteId>({north}) );
+    BOOST_CHECK( library.findSimilar(straightRoute(0,1,-15)) == std::vector<RouteLibrary::RouteId>({east}) );
+    BOOST_CHECK( library.findSimilar(straightRoute(0.6,0.8,5)) == std::vector<RouteLibrary::RouteId>({northEast}) );
+    BOOST_CHECK( library.findSimilar(straightRoute(1,0,40)).empty() );
+}
+
+BOOST_AUTO_TEST_CASE( DifferentSamplingIsSimilar )
+{
+    RouteLibrary library(20);
+    const RouteLibrary::RouteId id = library.add(straightRoute(1,0));
+    BOOST_CHECK( library.findSimilar({ offset(0,5), offset(2000,5) }) == std::vector<RouteLibrary::RouteId>({id}) );
+}
+
+BOOST_AUTO_TEST_CASE( DistantRoutesAreNotCandidates )
+{
+    RouteLibrary library(20);
+    for (int i = 0; i < 100; ++i)
+    {
+        std::vector<Position> route;
+        for (const Position & pos : straightRoute(1,0)) route.push_back(Position(pos.latitude() - i * 0.1, pos.longitude()));
+        library.add(route);
+    }
+    const std::vector<RouteLibrary::RouteId> candidates = library.candidates(straightRoute(1,0,10));
+    BOOST_CHECK( std::find(candidates.begin(), candidates.end(), 0) != candidates.end() );
+    BOOST_CHECK_LT( candidates.size() , 5 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidParameters )
+{
+    BOOST_CHECK_THROW( RouteLibrary(0) , std::invalid_argument );
+    BOOST_CHECK_THROW( RouteLibrary(20).add({}) , std::invalid_argument );
+    BOOST_CHECK_THROW( RouteLibrary(20).candidates({}) , std::invalid_argument );
+    BOOST_CHECK_THROW( RouteLibrary(20).findSimilar({}) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "geometry.h"
+#include "earth.h"
+#include "distance.h"
+#include "routeLibrary.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // SplitMix64 finaliser: a fast, well-mixed 64-bit hash.
+      std::uint64_t mix(std::uint64_t x)
+      {
+          x += 0x9E3779B97F4A7C15ULL;
+          x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+          x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+          return x ^ (x >> 31);
+      }
+
+      // Interleave the bits of the row and column, as in a geohash.
+      std::uint64_t interleave(std::uint32_t row, std::uint32_t col)
+      {
+          std::uint64_t cell = 0;
+          for (unsigned int bit = 0; bit < 32; ++bit)
+          {
+              cell |= static_cast<std::uint64_t>((col >> bit) & 1) << (2 * bit);
+              cell |= static_cast<std::uint64_t>((row >> bit) & 1) << (2 * bit + 1);
+          }
+          return cell;
+      }
+
+      void checkNotEmpty(const std::vector<Position> & route)
+      {
+          if (route.empty())
+              throw std::invalid_argument("A route must contain at least one route point.");
+      }
+  }
+
+  metres discreteFrechetDistance(const std::vector<Position> & route1, const std::vector<Position> & route2)
+  {
+      checkNotEmpty(route1);
+      checkNotEmpty(route2);
+
+      // frechet[j] holds the coupling distance for route1[0..i] and route2[0..j].
+      std::vector<metres> frechet(route2.size());
+      for (std::size_t i = 0; i < route1.size(); ++i)
+      {
+          metres diagonal = 0; // The previous row's value for column j-1.
+          for (std::size_t j = 0; j < route2.size(); ++j)
+          {
+              const metres d = Distance::Equirectangular::between(route1[i], route2[j]);
+              const metres above = frechet[j];
+              metres best;
+              if (i == 0 && j == 0) best = 0;
+              else if (i == 0) best = frechet[j-1];
+              else if (j == 0) best = above;
+              else best = std::min({ above, frechet[j-1], diagonal });
+
+              diagonal = above;
+              frechet[j] = std::max(best, d);
+          }
+      }
+      return frechet.back();
+  }
+
+  /////////////////////////////////////////////////////////////////////////////////////////
+
+  RouteLibrary::RouteLibrary(metres granularity, unsigned int numBands, unsigned int rowsPerBand)
+      : granularity(granularity), numBands(numBands), rowsPerBand(rowsPerBand)
+  {
+      if (granularity <= 0 || numBands == 0 || rowsPerBand == 0)
+          throw std::invalid_argument("Route library parameters must be positive.");
+
+      // Cells should be somewhat larger than the granularity, so that similar routes share most cells.
+      const degrees cellHeight = Earth::latitudeSubtendedBy(4 * granularity);
+      geohashBits = static_cast<unsigned int>(std::max(1.0, std::min(31.0, std::floor(std::log2(fullRotation / 2 / cellHeight)))));
+  }
+
+  RouteLibrary::RouteId RouteLibrary::add(const std::vector<Position> & route)
+  {
+      checkNotEmpty(route);
+
+      const RouteId id = static_cast<RouteId>(routes.size());
+      const Signature signature = signatureOf(route);
+      for (unsigned int band = 0; band < numBands; ++band)
+      {
+          buckets[bandHash(signature, band)].push_back(id);
+      }
+      routes.push_back(resampled(route, granularity / 2));
+      return id;
+  }
+
+  unsigned int RouteLibrary::numRoutes() const
+  {
+      return static_cast<unsigned int>(routes.size());
+  }
+
+  std::vector<RouteLibrary::RouteId> RouteLibrary::candidates(const std::vector<Position> & route) const
+  {
+      checkNotEmpty(route);
+
+      std::vector<RouteId> found;
+      const Signature signature = signatureOf(route);
+      for (unsigned int band = 0; band < numBands; ++band)
+      {
+          const auto bucket = buckets.find(bandHash(signature, band));
+          if (bucket != buckets.end()) found.insert(found.end(), bucket->second.begin(), bucket->second.end());
+      }
+
+      std::sort(found.begin(), found.end());
+      found.erase(std::unique(found.begin(), found.end()), found.end());
+      return found;
+  }
+
+  std::vector<RouteLibrary::RouteId> RouteLibrary::findSimilar(const std::vector<Position> & route) const
+  {
+      checkNotEmpty(route);
+
+      const std::vector<Position> query = resampled(route, granularity / 2);
+
+      std::vector<RouteId> similar;
+      for (RouteId id : candidates(route))
+      {
+          if (discreteFrechetDistance(query, routes[id]) <= granularity) similar.push_back(id);
+      }
+      return similar;
+  }
+
+  std::vector<Position> RouteLibrary::resampled(const std::vector<Position> & route, metres interval) const
+  {
+      std::vector<Position> points;
+      points.push_back(route.front());
+      for (std::size_t i = 1; i < route.size(); ++i)
+      {
+          const Position & start = route[i-1];
+          const Position & end = route[i];
+          const degrees deltaLon = normaliseDeg(end.longitude() - start.longitude());
+          const unsigned int steps = static_cast<unsigned int>(std::ceil(Distance::Equirectangular::between(start, end) / interval));
+          for (unsigned int step = 1; step < steps; ++step)
+          {
+              const double t = static_cast<double>(step) / steps;
+              points.push_back(Position(start.latitude() + t * (end.latitude() - start.latitude()),
+                                        normaliseDeg(start.longitude() + t * deltaLon),
+                                        start.elevation() + t * (end.elevation() - start.elevation())));
+          }
+          points.push_back(end);
+      }
+      return points;
+  }
+
+  RouteLibrary::Signature RouteLibrary::signatureOf(const std::vector<Position> & route) const
+  {
+      const double rowsPerDegree = std::ldexp(1.0, static_cast<int>(geohashBits)) / (2 * poleLatitude);
+      const double colsPerDegree = std::ldexp(1.0, static_cast<int>(geohashBits)) / fullRotation;
+      const std::int64_t lastRow = (std::int64_t(1) << geohashBits) - 1;
+      const std::int64_t lastCol = lastRow;
+
+      // The cells that the route passes through, and their neighbours.
+      const metres cellHeight = Earth::polarCircumference / 2 / (lastRow + 1);
+      std::unordered_set<std::uint64_t> cells;
+      for (const Position & pos : resampled(route, cellHeight / 2))
+      {
+          const std::int64_t row = static_cast<std::int64_t>((pos.latitude() + poleLatitude) * rowsPerDegree);
+          const std::int64_t col = static_cast<std::int64_t>((pos.longitude() + antiMeridianLongitude) * colsPerDegree);
+          for (std::int64_t r = row - 1; r <= row + 1; ++r)
+          {
+              for (std::int64_t c = col - 1; c <= col + 1; ++c)
+              {
+                  if (r < 0 || r > lastRow) continue;
+                  const std::int64_t wrappedCol = (c < 0) ? lastCol : (c > lastCol) ? 0 : c;
+                  cells.insert(interleave(static_cast<std::uint32_t>(r), static_cast<std::uint32_t>(wrappedCol)));
+              }
+          }
+      }
+
+      // MinHash: for each of the hash functions, the minimum hash over all cells.
+      Signature signature(numBands * rowsPerBand, std::numeric_limits<std::uint64_t>::max());
+      Signature seeds(signature.size());
+      for (std::size_t k = 0; k < seeds.size(); ++k) seeds[k] = mix(k);
+
+      for (std::uint64_t cell : cells)
+      {
+          for (std::size_t k = 0; k < signature.size(); ++k)
+          {
+              signature[k] = std::min(signature[k], mix(cell ^ seeds[k]));
+          }
+      }
+      return signature;
+  }
+
+  std::uint64_t RouteLibrary::bandHash(const Signature & signature, unsigned int band) const
+  {
+      std::uint64_t hash = mix(band);
+      for (unsigned int row = 0; row < rowsPerBand; ++row)
+      {
+          hash = mix(hash ^ signature[band * rowsPerBand + row]);
+      }
+      return hash;
+  }
+}
@@ -0,0 +1,118 @@
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "projection.h"
+#include "routeMatcher.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteMatching )
+
+const double percentageAccuracy = 0.5;
+const metres epsilon = 0.01;
+
+BOOST_AUTO_TEST_CASE( ClosestPointWithinSegment )
+{
+    // 1km due North in 100m steps.
+    std::vector<Position> positions;
+    for (int i = 0; i <= 10; ++i) positions.push_back(offset(i * 100, 0));
+    const RouteMatcher matcher(positions);
+
+    const RouteMatch match = matcher.closestPoint(offset(450, 30));
+    BOOST_CHECK_EQUAL( match.segment , 4 );
+    BOOST_CHECK_CLOSE( match.distance , 30 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( match.alongRoute , 450 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( match.closest.latitude() , offset(450, 0).latitude() , 0.0001 );
+}
+
+BOOST_AUTO_TEST_CASE( BeyondTheEnds )
+{
+    const RouteMatcher matcher({ offset(0,0), offset(1000,0) });
+
+    const RouteMatch beforeStart = matcher.closestPoint(offset(-200, 0));
+    BOOST_CHECK_SMALL( beforeStart.alongRoute , epsilon );
+    BOOST_CHECK_CLOSE( beforeStart.distance , 200 , percentageAccuracy );
+
+    const RouteMatch afterEnd = matcher.closestPoint(offset(1300, 0));
+    BOOST_CHECK_CLOSE( afterEnd.alongRoute , matcher.length() , percentageAccuracy );
+    BOOST_CHECK_CLOSE( afterEnd.distance , 300 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( ElevationIsInterpolated )
+{
+    const RouteMatcher matcher({ Position(52.9,-1.2,100), Position(53.0,-1.2,200) });
+    BOOST_CHECK_CLOSE( matcher.closestPoint(Position(52.925,-1.21)).closest.elevation() , 125 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( MatchesExhaustiveSearch )
+{
+    // A long pseudo-random walk, so that the R-tree has several levels.
+    std::vector<Position> positions;
+    metres north = 0, east = 0;
+    unsigned int seed = 12345;
+    for (int i = 0; i < 5000; ++i)
+    {
+        seed = seed * 1103515245 + 12345;
+        north += static_cast<int>((seed >> 16) % 201) - 100;
+        seed = seed * 1103515245 + 12345;
+        east += static_cast<int>((seed >> 16) % 201) - 100;
+        positions.push_back(offset(north, east));
+    }
+    const RouteMatcher matcher(positions);
+    const LocalProjection projection(positions.front());
+
+    for (int q = 0; q < 200; ++q)
+    {
+        seed = seed * 1103515245 + 12345;
+        const Position query = positions[(seed >> 16) % positions.size()];
+        const Position shifted = Position(query.latitude() + 0.001, query.longitude() - 0.0005);
+
+        metres bruteForce = Position::distanceBetween(shifted, positions.front());
+        for (std::size_t s = 0; s + 1 < positions.size(); ++s)
+        {
+            bruteForce = std::min(bruteForce, distanceToSegment(projection.toPlane(shifted),
+                                                                projection.toPlane(positions[s]),
+                                                                projection.toPlane(positions[s+1])));
+        }
+        // The matcher projects about a different origin, so allow for a small difference.
+        BOOST_CHECK_CLOSE( matcher.closestPoint(shifted).distance , bruteForce , 1 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( AcrossTheAntiMeridian )
+{
+    // ~2km due East along the 10th parallel, crossing the anti-meridian half way.
+    const RouteMatcher matcher({ Position(10, 179.99), Position(10, -179.99) });
+
+    const RouteMatch match = matcher.closestPoint(Position(10.0001, 180));
+    BOOST_CHECK_CLOSE( match.distance , 11.12 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( match.alongRoute , matcher.length() / 2 , percentageAccuracy );
+    BOOST_CHECK_CLOSE( match.closest.latitude() , 10 , 0.0001 );
+    BOOST_CHECK_CLOSE( std::abs(match.closest.longitude()) , 180 , 0.0001 );
+    BOOST_CHECK_SMALL( Position::distanceBetween(match.closest, Position(10, 180)) , 0.1 );
+}
+
+BOOST_AUTO_TEST_CASE( SinglePointRoute )
+{
+    const RouteMatcher matcher({ Earth::CityCampus });
+    const RouteMatch match = matcher.closestPoint(Earth::CliftonCampus);
+    BOOST_CHECK_CLOSE( match.distance , Position::distanceBetween(Earth::CityCampus, Earth::CliftonCampus) , percentageAccuracy );
+    BOOST_CHECK_EQUAL( match.alongRoute , 0 );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyRoute )
+{
+    BOOST_CHECK_THROW( RouteMatcher(std::vector<Position>()) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
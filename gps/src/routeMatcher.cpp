@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+#include "routeMatcher.h"
+
+namespace GPS
+{
+  namespace
+  {
+      /* The centre of the bounding box of the Positions.  Longitudes are measured relative to
+       * the first Position, so that a route crossing the anti-meridian is centred on it,
+       * rather than on the far side of the Earth.
+       */
+      Position centreOf(const std::vector<Position> & positions)
+      {
+          if (positions.empty())
+              throw std::invalid_argument("A route must contain at least one route point.");
+
+          const degrees firstLon = positions.front().longitude();
+          degrees minLat = positions.front().latitude(), maxLat = minLat;
+          degrees minLon = 0, maxLon = 0;
+          for (const Position & pos : positions)
+          {
+              const degrees lon = normaliseDeg(pos.longitude() - firstLon);
+              minLat = std::min(minLat, pos.latitude());
+              maxLat = std::max(maxLat, pos.latitude());
+              minLon = std::min(minLon, lon);
+              maxLon = std::max(maxLon, lon);
+          }
+          return Position((minLat + maxLat) / 2, normaliseDeg(firstLon + (minLon + maxLon) / 2));
+      }
+  }
+
+  RouteMatcher::RouteMatcher(const std::vector<Position> & routePoints)
+      : routePoints(routePoints),
+        projection(centreOf(routePoints)),
+        sums(routePoints)
+  {
+      points.reserve(routePoints.size());
+      for (const Position & pos : routePoints)
+      {
+          points.push_back(projection.toPlane(pos));
+      }
+      buildTree();
+  }
+
+  RouteMatch RouteMatcher::closestPoint(const Position & pos) const
+  {
+      if (routePoints.size() == 1)
+      {
+          return { routePoints.front(), Position::distanceBetween(pos, routePoints.front()), 0, 0 };
+      }
+
+      const PlanePoint p = projection.toPlane(pos);
+
+      /* Best-first search.  Nodes are queued by the distance to their bounding box (a lower
+       * bound for every segment within), segments by their actual distance; so the first
+       * segment to reach the front of the queue is the closest.
+       */
+      using Entry = std::tuple<metres, bool, unsigned int>; // (distance squared, is a node?, index)
+      std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+      queue.push(Entry(distanceSqr(p, nodes[root].box), true, root));
+
+      while (true)
+      {
+          const Entry top = queue.top();
+          queue.pop();
+          if (!std::get<1>(top))
+          {
+              const unsigned int segment = std::get<2>(top);
+              const double t = closestFractionAlong(p, points[segment], points[segment+1]);
+              const PlanePoint & start = points[segment];
+              const PlanePoint & end = points[segment+1];
+              const metres startElevation = routePoints[segment].elevation();
+              const metres endElevation = routePoints[segment+1].elevation();
+              const Position closest = projection.fromPlane({ start.x + t * (end.x - start.x), start.y + t * (end.y - start.y) },
+                                                            startElevation + t * (endElevation - startElevation));
+              const std::vector<metres> & cumulativeLengths = sums.cumulativeLengths();
+              const metres segmentLength = cumulativeLengths[segment+1] - cumulativeLengths[segment];
+              return { closest, std::sqrt(std::get<0>(top)), cumulativeLengths[segment] + t * segmentLength, segment };
+          }
+
+          const Node & node = nodes[std::get<2>(top)];
+          for (unsigned int i = node.firstChild; i < node.firstChild + node.numChildren; ++i)
+          {
+              const unsigned int child = children[i];
+              if (node.isLeaf)
+              {
+                  const metres d = distanceToSegment(p, points[child], points[child+1]);
+                  queue.push(Entry(d * d, false, child));
+              }
+              else
+              {
+                  queue.push(Entry(distanceSqr(p, nodes[child].box), true, child));
+              }
+          }
+      }
+  }
+
+  metres RouteMatcher::length() const
+  {
+      return sums.totalLength();
+  }
+
+  void RouteMatcher::buildTree()
+  {
+      const unsigned int numSegments = static_cast<unsigned int>(points.size()) - 1;
+      if (numSegments == 0) return;
+
+      std::vector<Rect> segmentBoxes;
+      std::vector<unsigned int> level; // Segments, then nodes, to be grouped into parent nodes.
+      for (unsigned int s = 0; s < numSegments; ++s)
+      {
+          segmentBoxes.push_back(segmentBox(s));
+          level.push_back(s);
+      }
+      bool isLeafLevel = true;
+
+      while (true)
+      {
+          auto boxOf = [&](unsigned int i) { return isLeafLevel ? segmentBoxes[i] : nodes[i].box; };
+
+          // Sort-Tile-Recursive: sort into vertical slices by x, then sort each slice by y.
+          std::sort(level.begin(), level.end(), [&](unsigned int a, unsigned int b)
+          {
+              return boxOf(a).minX + boxOf(a).maxX < boxOf(b).minX + boxOf(b).maxX;
+          });
+
+          const std::size_t numParents = (level.size() + nodeCapacity - 1) / nodeCapacity;
+          const std::size_t numSlices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(numParents))));
+          const std::size_t sliceSize = numSlices * nodeCapacity;
+          for (std::size_t first = 0; first < level.size(); first += sliceSize)
+          {
+              const std::size_t last = std::min(first + sliceSize, level.size());
+              std::sort(level.begin() + first, level.begin() + last, [&](unsigned int a, unsigned int b)
+              {
+                  return boxOf(a).minY + boxOf(a).maxY < boxOf(b).minY + boxOf(b).maxY;
+              });
+          }
+
+          // Pack each run of "nodeCapacity" entries into a parent node.
+          std::vector<unsigned int> parents;
+          for (std::size_t first = 0; first < level.size(); first += nodeCapacity)
+          {
+              const std::size_t last = std::min(first + nodeCapacity, level.size());
+              Node node = { boxOf(level[first]), static_cast<unsigned int>(children.size()),
+                            static_cast<unsigned int>(last - first), isLeafLevel };
+              for (std::size_t i = first; i < last; ++i)
+              {
+                  const Rect box = boxOf(level[i]);
+                  node.box.minX = std::min(node.box.minX, box.minX);
+                  node.box.minY = std::min(node.box.minY, box.minY);
+                  node.box.maxX = std::max(node.box.maxX, box.maxX);
+                  node.box.maxY = std::max(node.box.maxY, box.maxY);
+                  children.push_back(level[i]);
+              }
+              parents.push_back(static_cast<unsigned int>(nodes.size()));
+              nodes.push_back(node);
+          }
+
+          if (parents.size() == 1)
+          {
+              root = parents.front();
+              return;
+          }
+          level = parents;
+          isLeafLevel = false;
+      }
+  }
+
+  RouteMatcher::Rect RouteMatcher::segmentBox(unsigned int segment) const
+  {
+      const PlanePoint & a = points[segment];
+      const PlanePoint & b = points[segment+1];
+      return { std::min(a.x, b.x), std::min(a.y, b.y), std::max(a.x, b.x), std::max(a.y, b.y) };
+  }
+
+  metres RouteMatcher::distanceSqr(const PlanePoint & p, const Rect & box)
+  {
+      const metres dx = std::max(std::max(box.minX - p.x, 0.0), p.x - box.maxX);
+      const metres dy = std::max(std::max(box.minY - p.y, 0.0), p.y - box.maxY);
+      return dx*dx + dy*dy;
+  }
+}
@@ -0,0 +1,106 @@
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "earth.h"
+#include "distance.h"
+#include "routeSnapshot.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( RouteSnapshots )
+
+// Five route points, 10m apart, due North of the City Campus.
+RouteSnapshot makeSnapshot()
+{
+    std::vector<Position> positions;
+    for (int i = 0; i < 5; ++i)
+    {
+        positions.push_back(Position(Earth::CityCampus.latitude() + Earth::latitudeSubtendedBy(10 * i),
+                                     Earth::CityCampus.longitude()));
+    }
+    return RouteSnapshot("Northbound", positions, {"A","B","C","D","E"}, 5);
+}
+
+BOOST_AUTO_TEST_CASE( Accessors )
+{
+    const RouteSnapshot snapshot = makeSnapshot();
+    BOOST_CHECK_EQUAL( snapshot.name() , "Northbound" );
+    BOOST_CHECK_EQUAL( snapshot.numPositions() , 5 );
+    BOOST_CHECK_EQUAL( snapshot.positionName(2) , "C" );
+    BOOST_CHECK_EQUAL( snapshot[0].latitude() , Earth::CityCampus.latitude() );
+    BOOST_CHECK_EQUAL( snapshot.granularity() , 5 );
+    BOOST_CHECK_THROW( snapshot[5] , std::out_of_range );
+    BOOST_CHECK_THROW( snapshot.positionName(5) , std::out_of_range );
+
+    BOOST_CHECK_EQUAL( RouteSnapshot("", {}, {}, 5).name() , "Unnamed Route" );
+    BOOST_CHECK_THROW( RouteSnapshot("", { Earth::CityCampus }, {}, 5) , std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE( CopiesShareStorage )
+{
+    const RouteSnapshot original = makeSnapshot();
+    const RouteSnapshot copy = original;
+    BOOST_CHECK( copy.sharesStorageWith(original) );
+    BOOST_CHECK_EQUAL( &copy.positions() , &original.positions() );
+}
+
+BOOST_AUTO_TEST_CASE( WithGranularityMakesNewSnapshot )
+{
+    const RouteSnapshot original = makeSnapshot();
+    const RouteSnapshot thinned = original.withGranularity(15);
+
+    BOOST_CHECK( ! thinned.sharesStorageWith(original) );
+    BOOST_CHECK_EQUAL( original.numPositions() , 5 );
+    BOOST_CHECK_EQUAL( thinned.numPositions() , 3 );
+    BOOST_CHECK_EQUAL( thinned.positionName(1) , "C" );
+    BOOST_CHECK_EQUAL( thinned.positionName(2) , "E" );
+    BOOST_CHECK_EQUAL( thinned.granularity() , 15 );
+}
+
+BOOST_AUTO_TEST_CASE( StorageBytes )
+{
+    const std::vector<Position> positions(4, Earth::CityCampus);
+    const RouteSnapshot unnamed("", positions, {"","","",""}, 5);
+    const RouteSnapshot shortNames("", positions, {"A","B","C","D"}, 5);
+    const std::string longName(100, 'x');
+    const RouteSnapshot longNames("", positions, {longName,longName,longName,longName}, 5);
+
+    // Short names are stored within the std::string objects themselves.
+    BOOST_CHECK_GE( unnamed.storageBytes() , 4 * (sizeof(Position) + sizeof(std::string)) );
+    BOOST_CHECK_EQUAL( shortNames.storageBytes() , unnamed.storageBytes() );
+    BOOST_CHECK_GE( longNames.storageBytes() , unnamed.storageBytes() + 4 * longName.size() );
+}
+
+BOOST_AUTO_TEST_CASE( ConcurrentReaders )
+{
+    const RouteSnapshot shared = makeSnapshot();
+    const metres expected = pathLength(shared.positions());
+
+    std::atomic<int> mismatches(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 8; ++t)
+    {
+        readers.emplace_back([&]()
+        {
+            for (int i = 0; i < 1000; ++i)
+            {
+                const RouteSnapshot local = shared; // Copy between threads.
+                if (pathLength(local.positions()) != expected) ++mismatches;
+            }
+        });
+    }
+    for (std::thread & reader : readers) reader.join();
+
+    BOOST_CHECK_EQUAL( mismatches.load() , 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
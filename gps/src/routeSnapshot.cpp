@@ -0,0 +1,91 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "distance.h"
+#include "routeSnapshot.h"
+
+namespace GPS
+{
+  namespace
+  {
+      // The heap storage of a string, which is none for strings short enough to be stored in place.
+      std::size_t heapBytes(const std::string & s)
+      {
+          static const std::size_t inPlaceCapacity = std::string().capacity();
+          return (s.capacity() > inPlaceCapacity) ? s.capacity() + 1 : 0; // Including the terminator.
+      }
+  }
+
+  RouteSnapshot::RouteSnapshot(std::string routeName,
+                               std::vector<Position> positions,
+                               std::vector<std::string> positionNames,
+                               metres granularity)
+  {
+      if (positions.size() != positionNames.size())
+          throw std::invalid_argument("Every route point must have a (possibly empty) name.");
+
+      data = std::make_shared<const Data>(Data{ std::move(routeName), std::move(positions),
+                                                std::move(positionNames), granularity });
+  }
+
+  std::string RouteSnapshot::name() const
+  {
+      return data->routeName.empty() ? "Unnamed Route" : data->routeName;
+  }
+
+  unsigned int RouteSnapshot::numPositions() const
+  {
+      return static_cast<unsigned int>(data->positions.size());
+  }
+
+  Position RouteSnapshot::operator[](unsigned int index) const
+  {
+      return data->positions.at(index);
+  }
+
+  const std::string & RouteSnapshot::positionName(unsigned int index) const
+  {
+      return data->positionNames.at(index);
+  }
+
+  const std::vector<Position> & RouteSnapshot::positions() const
+  {
+      return data->positions;
+  }
+
+  metres RouteSnapshot::granularity() const
+  {
+      return data->granularity;
+  }
+
+  RouteSnapshot RouteSnapshot::withGranularity(metres granularity) const
+  {
+      std::vector<Position> positions;
+      std::vector<std::string> positionNames;
+      for (unsigned int i : thinnedIndices<Distance::Haversine>(data->positions, granularity))
+      {
+          positions.push_back(data->positions[i]);
+          positionNames.push_back(data->positionNames[i]);
+      }
+      return RouteSnapshot(data->routeName, std::move(positions), std::move(positionNames), granularity);
+  }
+
+  std::size_t RouteSnapshot::storageBytes() const
+  {
+      std::size_t bytes = sizeof(Data) + heapBytes(data->routeName)
+                          + data->positions.capacity() * sizeof(Position)
+                          + data->positionNames.capacity() * sizeof(std::string);
+      for (const std::string & positionName : data->positionNames)
+      {
+          bytes += heapBytes(positionName);
+      }
+      return bytes;
+  }
+
+  bool RouteSnapshot::sharesStorageWith(const RouteSnapshot & other) const
+  {
+      return data == other.data;
+  }
+}
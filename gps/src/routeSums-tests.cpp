@@ -0,0 +1,70 @@
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "earth.h"
+#include "distance.h"
+#include "routeSums.h"
+
+using namespace GPS;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( SubRouteQueries )
+
+const double percentageAccuracy = 0.0001;
+const metres epsilon = 0.0001;
+
+// Clifton (58m) -> City (53m) -> Clifton (58m) -> City (53m)
+const std::vector<Position> routePoints = { Earth::CliftonCampus, Earth::CityCampus, Earth::CliftonCampus, Earth::CityCampus };
+const metres leg = Position::distanceBetween(Earth::CliftonCampus, Earth::CityCampus);
+
+BOOST_AUTO_TEST_CASE( SubRouteLength )
+{
+    const RouteSums sums(routePoints);
+    BOOST_CHECK_EQUAL( sums.numPositions() , 4 );
+    BOOST_CHECK_CLOSE( sums.totalLength() , pathLength(routePoints) , percentageAccuracy );
+    BOOST_CHECK_CLOSE( sums.length(1,3) , 2 * leg , percentageAccuracy );
+    BOOST_CHECK_SMALL( sums.length(2,2) , epsilon );
+}
+
+BOOST_AUTO_TEST_CASE( SubRouteHeightGain )
+{
+    const RouteSums sums(routePoints);
+    BOOST_CHECK_CLOSE( sums.totalHeightGain() , 5 , percentageAccuracy );
+    BOOST_CHECK_SMALL( sums.heightGain(0,1) , epsilon );
+    BOOST_CHECK_CLOSE( sums.heightGain(1,3) , 5 , percentageAccuracy );
+}
+
+BOOST_AUTO_TEST_CASE( IndexAtDistance )
+{
+    const RouteSums sums(routePoints);
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(-1) , 0 );
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(0) , 0 );
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(leg / 2) , 0 );
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(sums.length(0,1)) , 1 );
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(2.5 * leg) , 2 );
+    BOOST_CHECK_EQUAL( sums.indexAtDistance(10 * leg) , 3 );
+}
+
+BOOST_AUTO_TEST_CASE( InvalidRanges )
+{
+    const RouteSums sums(routePoints);
+    BOOST_CHECK_THROW( sums.length(0,4) , std::out_of_range );
+    BOOST_CHECK_THROW( sums.heightGain(4,4) , std::out_of_range );
+    BOOST_CHECK_THROW( sums.length(2,1) , std::invalid_argument );
+    BOOST_CHECK_THROW( RouteSums(std::vector<Position>()).indexAtDistance(0) , std::out_of_range );
+}
+
+BOOST_AUTO_TEST_CASE( EmptyRoute )
+{
+    const RouteSums sums = RouteSums(std::vector<Position>());
+    BOOST_CHECK_EQUAL( sums.numPositions() , 0 );
+    BOOST_CHECK_EQUAL( sums.totalLength() , 0 );
+    BOOST_CHECK_EQUAL( sums.totalHeightGain() , 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
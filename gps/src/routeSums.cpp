@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "routeSums.h"
+
+namespace GPS
+{
+  RouteSums::RouteSums(const std::vector<Position> & routePoints)
+  {
+      lengthSums.reserve(routePoints.size());
+      heightGainSums.reserve(routePoints.size());
+      for (std::size_t i = 0; i < routePoints.size(); ++i)
+      {
+          if (i == 0)
+          {
+              lengthSums.push_back(0);
+              heightGainSums.push_back(0);
+              continue;
+          }
+
+          const metres climb = routePoints[i].elevation() - routePoints[i-1].elevation();
+          lengthSums.push_back(lengthSums.back() + Position::distanceBetween(routePoints[i-1], routePoints[i]));
+          heightGainSums.push_back(heightGainSums.back() + std::max(climb, 0.0));
+      }
+  }
+
+  unsigned int RouteSums::numPositions() const
+  {
+      return static_cast<unsigned int>(lengthSums.size());
+  }
+
+  metres RouteSums::length(unsigned int from, unsigned int to) const
+  {
+      checkRange(from, to);
+      return lengthSums[to] - lengthSums[from];
+  }
+
+  metres RouteSums::heightGain(unsigned int from, unsigned int to) const
+  {
+      checkRange(from, to);
+      return heightGainSums[to] - heightGainSums[from];
+  }
+
+  metres RouteSums::totalLength() const
+  {
+      return lengthSums.empty() ? 0 : lengthSums.back();
+  }
+
+  metres RouteSums::totalHeightGain() const
+  {
+      return heightGainSums.empty() ? 0 : heightGainSums.back();
+  }
+
+  unsigned int RouteSums::indexAtDistance(metres distance) const
+  {
+      if (lengthSums.empty())
+          throw std::out_of_range("Cannot find a route point in an empty route.");
+
+      const auto after = std::upper_bound(lengthSums.begin() + 1, lengthSums.end(), distance);
+      return static_cast<unsigned int>(after - lengthSums.begin()) - 1;
+  }
+
+  const std::vector<metres> & RouteSums::cumulativeLengths() const
+  {
+      return lengthSums;
+  }
+
+  void RouteSums::checkRange(unsigned int from, unsigned int to) const
+  {
+      if (from >= lengthSums.size() || to >= lengthSums.size())
+          throw std::out_of_range("Route point index out of range: the route has " + std::to_string(lengthSums.size()) + " points.");
+
+      if (from > to)
+          throw std::invalid_argument("The start of a sub-route must not be after its end.");
+  }
+}
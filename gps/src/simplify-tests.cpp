@@ -0,0 +1,66 @@
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "earth.h"
+#include "simplify.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( Simplify )
+
+const std::vector<Simplification> methods = { Simplification::DouglasPeucker, Simplification::VisvalingamWhyatt };
+
+BOOST_AUTO_TEST_CASE( StraightLineReducesToEndPoints )
+{
+    std::vector<Position> positions;
+    for (int i = 0; i <= 100; ++i) positions.push_back(offset(i * 10, i * 0.01));
+
+    for (Simplification method : methods)
+    {
+        BOOST_CHECK( simplifiedIndices(positions, 1, method) == std::vector<unsigned int>({0,100}) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( CornerIsRetained )
+{
+    std::vector<Position> positions;
+    for (int i = 0; i <= 50; ++i) positions.push_back(offset(i * 10, 0));
+    for (int i = 1; i <= 50; ++i) positions.push_back(offset(500, i * 10));
+
+    for (Simplification method : methods)
+    {
+        BOOST_CHECK( simplifiedIndices(positions, 5, method) == std::vector<unsigned int>({0,50,100}) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( DeviationsBeyondToleranceAreRetained )
+{
+    // A zig-zag with a 20 metre amplitude.
+    std::vector<Position> positions;
+    for (int i = 0; i <= 20; ++i) positions.push_back(offset(i * 100, (i % 2) * 20));
+
+    for (Simplification method : methods)
+    {
+        BOOST_CHECK_EQUAL( simplify(positions, 10, method).size() , positions.size() );
+        BOOST_CHECK_EQUAL( simplify(positions, 30, method).size() , 2 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( ShortRoutesAreUnchanged )
+{
+    for (Simplification method : methods)
+    {
+        BOOST_CHECK( simplify(std::vector<Position>(), 10, method).empty() );
+        BOOST_CHECK_EQUAL( simplify({ Earth::CityCampus }, 10, method).size() , 1 );
+        BOOST_CHECK_EQUAL( simplify({ Earth::CityCampus, Earth::CityCampus }, 10, method).size() , 2 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
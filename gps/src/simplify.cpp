@@ -0,0 +1,150 @@
+#include <queue>
+#include <utility>
+#include <functional>
+
+#include "projection.h"
+#include "simplify.h"
+
+namespace GPS
+{
+  namespace
+  {
+      std::vector<PlanePoint> projected(const std::vector<Position> & positions)
+      {
+          const LocalProjection projection(positions.front());
+          std::vector<PlanePoint> points;
+          points.reserve(positions.size());
+          for (const Position & pos : positions)
+          {
+              points.push_back(projection.toPlane(pos));
+          }
+          return points;
+      }
+
+      std::vector<bool> douglasPeucker(const std::vector<PlanePoint> & points, metres tolerance)
+      {
+          std::vector<bool> retained(points.size(), false);
+          retained.front() = retained.back() = true;
+
+          // Sub-ranges [first,last] still to be examined; an explicit stack avoids deep recursion.
+          std::vector<std::pair<unsigned int, unsigned int>> pending;
+          pending.push_back({0, static_cast<unsigned int>(points.size() - 1)});
+
+          while (!pending.empty())
+          {
+              const unsigned int first = pending.back().first;
+              const unsigned int last = pending.back().second;
+              pending.pop_back();
+
+              metres maxDeviation = 0;
+              unsigned int furthest = first;
+              for (unsigned int i = first + 1; i < last; ++i)
+              {
+                  const metres deviation = distanceToSegment(points[i], points[first], points[last]);
+                  if (deviation > maxDeviation)
+                  {
+                      maxDeviation = deviation;
+                      furthest = i;
+                  }
+              }
+
+              if (maxDeviation > tolerance)
+              {
+                  retained[furthest] = true;
+                  pending.push_back({first, furthest});
+                  pending.push_back({furthest, last});
+              }
+          }
+
+          return retained;
+      }
+
+      std::vector<bool> visvalingamWhyatt(const std::vector<PlanePoint> & points, metres tolerance)
+      {
+          const unsigned int n = static_cast<unsigned int>(points.size());
+          std::vector<bool> retained(n, true);
+
+          // The remaining points form a doubly-linked list.
+          std::vector<unsigned int> prev(n), next(n);
+          for (unsigned int i = 0; i < n; ++i)
+          {
+              prev[i] = i - 1;
+              next[i] = i + 1;
+          }
+
+          // The deviation of each interior point from the line joining its current neighbours.
+          std::vector<metres> deviation(n, 0);
+          auto deviationOf = [&](unsigned int i)
+          {
+              return distanceToSegment(points[i], points[prev[i]], points[next[i]]);
+          };
+
+          // Min-heap of (deviation,index).  Entries are invalidated lazily: an entry is stale
+          // if the point has since been discarded or its deviation has been recomputed.
+          using Entry = std::pair<metres, unsigned int>;
+          std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+          for (unsigned int i = 1; i + 1 < n; ++i)
+          {
+              deviation[i] = deviationOf(i);
+              heap.push({deviation[i], i});
+          }
+
+          while (!heap.empty())
+          {
+              const Entry top = heap.top();
+              heap.pop();
+              const unsigned int i = top.second;
+              if (!retained[i] || top.first != deviation[i]) continue;
+              if (top.first > tolerance) break;
+
+              retained[i] = false;
+              next[prev[i]] = next[i];
+              prev[next[i]] = prev[i];
+
+              for (unsigned int neighbour : {prev[i], next[i]})
+              {
+                  if (neighbour == 0 || neighbour == n - 1) continue;
+                  deviation[neighbour] = deviationOf(neighbour);
+                  heap.push({deviation[neighbour], neighbour});
+              }
+          }
+
+          return retained;
+      }
+  }
+
+  std::vector<unsigned int> simplifiedIndices(const std::vector<Position> & positions,
+                                              metres tolerance,
+                                              Simplification method)
+  {
+      std::vector<unsigned int> indices;
+      if (positions.size() <= 2)
+      {
+          for (unsigned int i = 0; i < positions.size(); ++i) indices.push_back(i);
+          return indices;
+      }
+
+      const std::vector<PlanePoint> points = projected(positions);
+      const std::vector<bool> retained = (method == Simplification::DouglasPeucker)
+                                         ? douglasPeucker(points, tolerance)
+                                         : visvalingamWhyatt(points, tolerance);
+
+      for (unsigned int i = 0; i < retained.size(); ++i)
+      {
+          if (retained[i]) indices.push_back(i);
+      }
+      return indices;
+  }
+
+  std::vector<Position> simplify(const std::vector<Position> & positions,
+                                 metres tolerance,
+                                 Simplification method)
+  {
+      std::vector<Position> simplified;
+      for (unsigned int i : simplifiedIndices(positions, tolerance, method))
+      {
+          simplified.push_back(positions[i]);
+      }
+      return simplified;
+  }
+}
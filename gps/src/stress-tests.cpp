@@ -0,0 +1,288 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE StressTests
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "distance.h"
+#include "parseNMEA.h"
+#include "nmeaStream.h"
+#include "nmeaPipeline.h"
+#include "routeSums.h"
+#include "routeMatcher.h"
+#include "testHelpers.h"
+
+using namespace GPS;
+using namespace GPS::Testing;
+
+/* Regression tests for the parallel, streaming and prefix-sum fast paths, on inputs far
+ * larger than the logs in logs/NMEA.  Each fast path must give results bit-identical to
+ * the sequential reference implementation.
+ *
+ * Boost.Test assertions are not thread-safe, so workloads run on several threads and
+ * their results are checked on the main thread once the threads have been joined.
+ * Build with "qmake CONFIG+=asan" or "qmake CONFIG+=tsan" for sanitizer runs.
+ */
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  const unsigned int numSentences = 200000;
+
+  // The number of concurrent workloads; at least 2, so that there is some contention.
+  unsigned int numThreads()
+  {
+      return std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+  }
+
+  std::string checksum(const std::string & body)
+  {
+      unsigned char sum = 0;
+      for (char c : body) sum ^= static_cast<unsigned char>(c);
+      char hex[3];
+      std::snprintf(hex, sizeof(hex), "%02X", sum);
+      return hex;
+  }
+
+  // Formats an angle, in units of 1e-4 minutes, as NMEA "(d)ddmm.mmmm".
+  std::string nmeaAngle(long units, int degreeDigits)
+  {
+      const long absUnits = std::labs(units);
+      char text[32];
+      std::snprintf(text, sizeof(text), "%0*ld%02ld.%04ld", degreeDigits, absUnits / 600000,
+                    (absUnits % 600000) / 10000, absUnits % 10000);
+      return text;
+  }
+
+  /* Generates a log of a random walk, with a deterministic mix of GLL, GGA and RMC
+   * sentences from all supported talkers, interspersed with sentences that must be ignored:
+   * unsupported formats, corrupted checksums, truncated lines, blank lines and CRLF endings.
+   */
+  std::string generateLog(unsigned int numLines, unsigned int seed)
+  {
+      const std::vector<std::string> talkers = { "GP", "GN", "GL", "GA", "GB" };
+      std::mt19937 generator(seed);
+      std::uniform_int_distribution<int> step(-60, 60); // ~0.1 metres per 1e-4 minutes.
+      std::uniform_int_distribution<int> kind(0, 99);
+
+      long latitude = 37 * 600000 + 231622;  // 3723.1622 N
+      long longitude = -(5 * 600000 + 595788); // 00559.5788 W
+      double elevation = 30;
+
+      std::string log;
+      log.reserve(numLines * 80);
+      for (unsigned int i = 0; i < numLines; ++i)
+      {
+          latitude += step(generator);
+          longitude += step(generator);
+          elevation += step(generator) / 20.0;
+
+          const std::string talker = talkers[i % talkers.size()];
+          const std::string lat = nmeaAngle(latitude, 2) + (latitude < 0 ? ",S" : ",N");
+          const std::string lon = nmeaAngle(longitude, 3) + (longitude < 0 ? ",W" : ",E");
+          char ele[16];
+          std::snprintf(ele, sizeof(ele), "%.1f", elevation);
+
+          std::string body;
+          const int k = kind(generator);
+          if (k < 30)      body = talker + "GLL," + lat + "," + lon + ",094627.000,A";
+          else if (k < 60) body = talker + "GGA,094627.000," + lat + "," + lon + ",1,8,0.9," + ele + ",M,,M,,";
+          else if (k < 85) body = talker + "RMC,094627.000,A," + lat + "," + lon + ",0.000,0.00,150914,,A";
+          else if (k < 90) body = talker + "GSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00";
+          else if (k < 93) body = "GPXYZ,1,2,3";
+
+          std::string line;
+          if (body.empty())  line = "";
+          else if (k < 96)   line = "$" + body + "*" + checksum(body);
+          else if (k < 98)   line = "$" + body + "*" + checksum(body + "x");
+          else               line = "$" + body.substr(0, body.size() / 2);
+
+          log += line;
+          log += (i % 7 == 0) ? "\r\n" : "\n";
+      }
+      return log;
+  }
+
+  // A large generated log, written to a temporary file, and its sequentially-parsed route.
+  struct LargeLog
+  {
+      std::string contents;
+      TempFile file;
+      const std::string & path;
+      std::vector<Position> reference;
+
+      LargeLog()
+        : contents(generateLog(numSentences, 181026)),
+          file(contents),
+          path(file.path),
+          reference(routeFromNMEALog(path)) {}
+  };
+
+  const LargeLog & largeLog()
+  {
+      static const LargeLog log;
+      return log;
+  }
+
+  // Feeds the data to a stream reader in randomly-sized chunks.
+  std::vector<Position> streamInChunks(const std::string & data, unsigned int seed)
+  {
+      std::vector<Position> route;
+      NMEAStreamReader reader([&route](const Position & pos) { route.push_back(pos); });
+
+      std::mt19937 generator(seed);
+      std::uniform_int_distribution<std::size_t> chunkSize(1, 4096);
+      for (std::size_t i = 0; i < data.size();)
+      {
+          const std::size_t length = std::min(chunkSize(generator), data.size() - i);
+          reader.consume(data.data() + i, length);
+          i += length;
+      }
+      reader.finish();
+      return route;
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( LargeInputs )
+
+BOOST_AUTO_TEST_CASE( GeneratedLogIsRealistic )
+{
+    // Most lines, but not all, should yield Positions.
+    const LargeLog & log = largeLog();
+    BOOST_CHECK_GT( log.reference.size() , numSentences / 2 );
+    BOOST_CHECK_LT( log.reference.size() , numSentences );
+}
+
+BOOST_AUTO_TEST_CASE( PipelinedMatchesSequential )
+{
+    const LargeLog & log = largeLog();
+    BOOST_CHECK( bitIdentical(routeFromNMEALogPipelined(log.path), log.reference) );
+    BOOST_CHECK( bitIdentical(routeFromNMEALogPipelined(log.path, {0, 1, 2, 3, 4}), log.reference) );
+}
+
+BOOST_AUTO_TEST_CASE( StreamingMatchesSequential )
+{
+    const LargeLog & log = largeLog();
+    for (unsigned int seed = 1; seed <= 3; ++seed)
+    {
+        BOOST_CHECK( bitIdentical(streamInChunks(log.contents, seed), log.reference) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( PollerMatchesSequential )
+{
+    const LargeLog & log = largeLog();
+    const unsigned int numStreams = numThreads();
+
+    NMEAStreamPoller poller;
+    std::vector<std::vector<Position>> routes(numStreams);
+    std::vector<std::thread> writers;
+    std::vector<int> readEnds;
+
+    for (unsigned int i = 0; i < numStreams; ++i)
+    {
+        int pipeEnds[2];
+        BOOST_REQUIRE_EQUAL( ::pipe2(pipeEnds, O_NONBLOCK) , 0 );
+        ::fcntl(pipeEnds[1], F_SETFL, 0); // Only the reading end should be non-blocking.
+        readEnds.push_back(pipeEnds[0]);
+
+        std::vector<Position> & route = routes[i];
+        poller.add(pipeEnds[0], [&route](const Position & pos) { route.push_back(pos); });
+
+        // Writer threads make no assertions; failures show up as missing Positions.
+        const int writeEnd = pipeEnds[1];
+        const std::string & data = log.contents;
+        writers.emplace_back([&data,writeEnd,i]() {
+            const std::size_t chunkSize = 512 + 997 * i;
+            for (std::size_t pos = 0; pos < data.size(); pos += chunkSize)
+            {
+                const std::size_t length = std::min(chunkSize, data.size() - pos);
+                if (::write(writeEnd, data.data() + pos, length) != ssize_t(length)) break;
+            }
+            ::close(writeEnd);
+        });
+    }
+
+    while (poller.numStreams() > 0) poller.poll(-1);
+    for (std::thread & writer : writers) writer.join();
+    for (int readEnd : readEnds) ::close(readEnd);
+
+    for (const std::vector<Position> & route : routes)
+    {
+        BOOST_CHECK( bitIdentical(route, log.reference) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( PrefixSumsMatchPathLength )
+{
+    const std::vector<Position> & route = largeLog().reference;
+    const RouteSums sums(route);
+
+    BOOST_CHECK( bitIdentical(sums.totalLength(), pathLength(route)) );
+    BOOST_CHECK( bitIdentical(RouteMatcher(route).length(), pathLength(route)) );
+
+    metres heightGain = 0;
+    for (std::size_t i = 1; i < route.size(); ++i)
+    {
+        heightGain += std::max(route[i].elevation() - route[i-1].elevation(), 0.0);
+    }
+    BOOST_CHECK( bitIdentical(sums.totalHeightGain(), heightGain) );
+
+    // Sub-route lengths are differences of prefix sums, so only agree to within rounding.
+    const unsigned int from = sums.numPositions() / 3;
+    const unsigned int to = 2 * sums.numPositions() / 3;
+    const std::vector<Position> subRoute(route.begin() + from, route.begin() + to + 1);
+    BOOST_CHECK_CLOSE( sums.length(from, to) , pathLength(subRoute) , 1e-6 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE( ConcurrentRuns )
+
+BOOST_AUTO_TEST_CASE( AllPathsAgreeUnderContention )
+{
+    const LargeLog & log = largeLog();
+    const unsigned int n = numThreads();
+
+    // Every thread runs every path; results are checked after all the threads have finished.
+    std::vector<std::vector<Position>> sequential(n), pipelined(n), streamed(n);
+    std::vector<metres> lengths(n);
+    std::vector<std::thread> workers;
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        workers.emplace_back([&,i]() {
+            sequential[i] = routeFromNMEALog(log.path);
+            pipelined[i] = routeFromNMEALogPipelined(log.path);
+            streamed[i] = streamInChunks(log.contents, i + 1);
+            lengths[i] = RouteSums(streamed[i]).totalLength();
+        });
+    }
+    for (std::thread & worker : workers) worker.join();
+
+    const metres referenceLength = pathLength(log.reference);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        BOOST_CHECK( bitIdentical(sequential[i], log.reference) );
+        BOOST_CHECK( bitIdentical(pipelined[i], log.reference) );
+        BOOST_CHECK( bitIdentical(streamed[i], log.reference) );
+        BOOST_CHECK( bitIdentical(lengths[i], referenceLength) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+/////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,87 @@
+#ifndef TESTHELPERS_H_181026
+#define TESTHELPERS_H_181026
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "types.h"
+#include "earth.h"
+#include "position.h"
+
+namespace GPS
+{
+  // Fixtures shared by the test suites.
+  namespace Testing
+  {
+      // A Position "north" and "east" metres from the origin (by default, the Clifton Campus).
+      inline Position offset(metres north, metres east, const Position & origin = Earth::CliftonCampus)
+      {
+          return Position(origin.latitude() + Earth::latitudeSubtendedBy(north),
+                          origin.longitude() + Earth::longitudeSubtendedBy(east, origin.latitude()));
+      }
+
+      // Compares bit patterns rather than values, so that -0.0 and 0.0 (or two NaNs) are distinguished.
+      inline bool bitIdentical(double x, double y)
+      {
+          return std::memcmp(&x, &y, sizeof(double)) == 0;
+      }
+
+      // Do the routes have the same Positions, with bit-identical coordinates?
+      inline bool bitIdentical(const std::vector<Position> & route1, const std::vector<Position> & route2)
+      {
+          if (route1.size() != route2.size()) return false;
+          for (std::size_t i = 0; i < route1.size(); ++i)
+          {
+              if (!bitIdentical(route1[i].latitude(), route2[i].latitude()) ||
+                  !bitIdentical(route1[i].longitude(), route2[i].longitude()) ||
+                  !bitIdentical(route1[i].elevation(), route2[i].elevation())) return false;
+          }
+          return true;
+      }
+
+      inline std::string fileContents(const std::string & filepath)
+      {
+          std::ifstream file(filepath, std::ios::binary);
+          std::ostringstream contents;
+          contents << file.rdbuf();
+          return contents.str();
+      }
+
+      // A temporary file, deleted on destruction.
+      struct TempFile
+      {
+          std::string path;
+
+          explicit TempFile(const std::string & contents)
+          {
+              char name[] = "/tmp/gpsTestXXXXXX";
+              const int fileDescriptor = ::mkstemp(name);
+              if (fileDescriptor < 0)
+                  throw std::system_error(errno, std::generic_category(), "Failed to create temporary file");
+              ::close(fileDescriptor);
+              path = name;
+              write(contents);
+          }
+
+          TempFile(const TempFile &) = delete;
+          TempFile & operator=(const TempFile &) = delete;
+
+          ~TempFile() { ::unlink(path.c_str()); }
+
+          void write(const std::string & contents) const
+          {
+              std::ofstream(path, std::ios::binary) << contents;
+          }
+      };
+  }
+}
+
+#endif